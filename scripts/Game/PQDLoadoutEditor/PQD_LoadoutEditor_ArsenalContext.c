@@ -0,0 +1,205 @@
+// PQD Loadout Editor - Arsenal Context
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Server-side components and prices of an arsenal, resolved once and shared by every storage request
+
+//------------------------------------------------------------------------------------------------
+//! Everything storage requests need from one arsenal, get instances through PQD_ArsenalContext.Get
+//! Entity and components are weak references, a deleted arsenal leaves them null and the context is
+//! dropped on the next lookup so a reused RplId never reaches a stale arsenal
+sealed class PQD_ArsenalContext
+{
+	// Arsenals kept around, dead ones are swept first when full
+	static const int MAX_CACHED_CONTEXTS = 64;
+	
+	protected static ref map<RplId, ref PQD_ArsenalContext> s_mCache = new map<RplId, ref PQD_ArsenalContext>();
+	
+	// Metrics
+	protected static int s_iHitCount;
+	protected static int s_iBuildCount;
+	
+	RplId rplId;
+	IEntity arsenalEntity;
+	SCR_ArsenalComponent arsenalComponent;
+	SCR_FactionAffiliationComponent factionAffiliation; // Null if the arsenal has no faction affiliation
+	SCR_ResourceComponent resourceComponent; // Null if the arsenal has no supplies
+	SCR_ResourceConsumer consumer;
+	SCR_ResourceGenerator generator;
+	SCR_Faction faction;
+	SCR_EArsenalSupplyCostType costType;
+	
+	// Price table of this arsenal, filled on demand
+	protected ref map<ResourceName, float> m_mSupplyCost = new map<ResourceName, float>();
+	protected ref map<ResourceName, SCR_ECharacterRank> m_mRequiredRank = new map<ResourceName, SCR_ECharacterRank>();
+	
+	//------------------------------------------------------------------------------------------------
+	//! Context of the arsenal replicated as rplId, null if it does not exist or has no arsenal component
+	static PQD_ArsenalContext Get(RplId rplId)
+	{
+		if (!rplId.IsValid())
+			return null;
+		
+		PQD_ArsenalContext context = s_mCache.Get(rplId);
+		if (context)
+		{
+			if (context.IsAlive())
+			{
+				s_iHitCount++;
+				context.Refresh();
+				return context;
+			}
+			
+			s_mCache.Remove(rplId);
+		}
+		
+		context = Build(rplId);
+		if (!context)
+			return null;
+		
+		if (s_mCache.Count() >= MAX_CACHED_CONTEXTS)
+			SweepDeadContexts();
+		
+		// Every cached arsenal still exists, start over
+		if (s_mCache.Count() >= MAX_CACHED_CONTEXTS)
+			s_mCache.Clear();
+		
+		s_mCache.Set(rplId, context);
+		return context;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static PQD_ArsenalContext GetForEntity(IEntity arsenalEntity)
+	{
+		if (!arsenalEntity)
+			return null;
+		
+		return Get(Replication.FindId(arsenalEntity));
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void Invalidate(RplId rplId)
+	{
+		s_mCache.Remove(rplId);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void ClearCache()
+	{
+		s_mCache.Clear();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static PQD_ArsenalContext Build(RplId rplId)
+	{
+		IEntity arsenalEntity = PQD_Helpers.GetEntityFromRplId(rplId);
+		if (!arsenalEntity)
+			return null;
+		
+		SCR_ArsenalComponent arsenalComponent = SCR_ArsenalComponent.Cast(arsenalEntity.FindComponent(SCR_ArsenalComponent));
+		if (!arsenalComponent)
+			return null;
+		
+		PQD_ArsenalContext context = new PQD_ArsenalContext();
+		context.rplId = rplId;
+		context.arsenalEntity = arsenalEntity;
+		context.arsenalComponent = arsenalComponent;
+		context.factionAffiliation = SCR_FactionAffiliationComponent.Cast(arsenalEntity.FindComponent(SCR_FactionAffiliationComponent));
+		context.resourceComponent = SCR_ResourceComponent.FindResourceComponent(arsenalEntity);
+		if (context.resourceComponent)
+		{
+			context.consumer = context.resourceComponent.GetConsumer(EResourceGeneratorID.DEFAULT, EResourceType.SUPPLIES);
+			context.generator = context.resourceComponent.GetGenerator(EResourceGeneratorID.DEFAULT, EResourceType.SUPPLIES);
+		}
+		
+		context.Refresh();
+		
+		s_iBuildCount++;
+		return context;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void SweepDeadContexts()
+	{
+		array<RplId> deadIds = {};
+		foreach (RplId rplId, PQD_ArsenalContext context : s_mCache)
+		{
+			if (!context.IsAlive())
+				deadIds.Insert(rplId);
+		}
+		
+		foreach (RplId rplId : deadIds)
+		{
+			s_mCache.Remove(rplId);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected bool IsAlive()
+	{
+		return arsenalEntity && arsenalComponent && !arsenalEntity.IsDeleted();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Drop the price table when the arsenal changed hands or switched cost type
+	//! Catalog prices are fixed for the session, these are the only ways the prices of an arsenal change
+	protected void Refresh()
+	{
+		SCR_Faction assignedFaction = arsenalComponent.GetAssignedFaction();
+		SCR_EArsenalSupplyCostType assignedCostType = arsenalComponent.GetSupplyCostType();
+		
+		if (assignedFaction == faction && assignedCostType == costType)
+			return;
+		
+		faction = assignedFaction;
+		costType = assignedCostType;
+		m_mSupplyCost.Clear();
+		m_mRequiredRank.Clear();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Supply cost of an item before the consumer buy multiplier, 0 if the arsenal does not use supplies
+	float GetItemSupplyCost(ResourceName prefab)
+	{
+		if (!arsenalComponent.IsArsenalUsingSupplies())
+			return 0;
+		
+		float cost;
+		if (m_mSupplyCost.Find(prefab, cost))
+			return cost;
+		
+		cost = PQD_Helpers.GetItemSupplyCost(arsenalComponent, prefab);
+		m_mSupplyCost.Set(prefab, cost);
+		return cost;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	SCR_ECharacterRank GetItemRequiredRank(ResourceName prefab)
+	{
+		SCR_ECharacterRank rank;
+		if (m_mRequiredRank.Find(prefab, rank))
+			return rank;
+		
+		rank = PQD_Helpers.GetItemRequiredRank(arsenalComponent, prefab);
+		m_mRequiredRank.Set(prefab, rank);
+		return rank;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetHitCount()
+	{
+		return s_iHitCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetBuildCount()
+	{
+		return s_iBuildCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void ResetMetrics()
+	{
+		s_iHitCount = 0;
+		s_iBuildCount = 0;
+	}
+}
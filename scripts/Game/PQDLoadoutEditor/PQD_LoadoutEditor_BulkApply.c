@@ -0,0 +1,342 @@
+// PQD Loadout Editor - Bulk Admin Loadout Apply
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Server-side queue applying one admin loadout to a squad, a faction or a set of AI characters
+
+//------------------------------------------------------------------------------------------------
+//! Character receiving the kit, playerId is 0 for AI
+sealed class PQD_BulkApplyTarget
+{
+	int playerId;
+	IEntity entity;
+}
+
+//------------------------------------------------------------------------------------------------
+//! One SET_AI_LOADOUT_ADMIN request and its progress
+sealed class PQD_BulkApplyJob
+{
+	PQD_PlayerControllerComponent requester;
+	ref PQD_LoadoutRequest request;
+	ResourceName prefab;
+	string loadoutData;
+	string factionKey;
+	string kitFactionKey; // Faction the kit was saved for, empty if not recorded
+	ref array<ref PQD_BulkApplyTarget> targets = {};
+	int targetCount;
+	int appliedCount;
+	int skippedCount;
+	int failedCount;
+}
+
+//------------------------------------------------------------------------------------------------
+//! Static queue of bulk applies, targets are replaced under the respawn kit per-frame budget
+class PQD_BulkLoadoutApplyQueue
+{
+	protected static ref array<ref PQD_BulkApplyJob> s_aJobs = {};
+	protected static bool s_bTicking;
+	
+	//------------------------------------------------------------------------------------------------
+	//! Resolve the characters a bulk request targets
+	static void CollectTargets(PQD_LoadoutRequest request, int adminPlayerId, string adminFactionKey, notnull array<ref PQD_BulkApplyTarget> targets)
+	{
+		switch (request.bulkScope)
+		{
+			case PQD_BulkApplyScope.SQUAD:
+				SCR_GroupsManagerComponent groupsManager = SCR_GroupsManagerComponent.GetInstance();
+				if (!groupsManager)
+					break;
+				
+				SCR_AIGroup group = groupsManager.GetPlayerGroup(adminPlayerId);
+				if (!group)
+					break;
+				
+				foreach (int memberId : group.GetPlayerIDs())
+				{
+					AddPlayerTarget(memberId, targets);
+				}
+				
+				// AI members of a player group live in its slave group
+				if (group.GetSlave())
+					AddGroupTargets(group.GetSlave(), targets);
+				break;
+			
+			case PQD_BulkApplyScope.FACTION:
+				string targetFactionKey = GetTargetFactionKey(request, adminFactionKey);
+				
+				array<int> playerIds = {};
+				GetGame().GetPlayerManager().GetPlayers(playerIds);
+				
+				foreach (int playerId : playerIds)
+				{
+					string playerFactionKey;
+					if (PQD_Helpers.GetPlayerEntityFactionKey(playerId, playerFactionKey) && playerFactionKey == targetFactionKey)
+						AddPlayerTarget(playerId, targets);
+				}
+				break;
+			
+			case PQD_BulkApplyScope.ENTITIES:
+				foreach (RplId rplId : request.bulkTargets)
+				{
+					IEntity entity = PQD_Helpers.GetEntityFromRplId(rplId);
+					if (!entity)
+						continue;
+					
+					SCR_AIGroup aiGroup = SCR_AIGroup.Cast(entity);
+					if (aiGroup)
+					{
+						AddGroupTargets(aiGroup, targets);
+						continue;
+					}
+					
+					int controllingPlayerId = GetGame().GetPlayerManager().GetPlayerIdFromControlledEntity(entity);
+					if (controllingPlayerId > 0)
+						AddPlayerTarget(controllingPlayerId, targets);
+					else if (PQD_Helpers.FindAIAgent(entity))
+						AddTarget(0, entity, targets);
+				}
+				break;
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Faction a FACTION scope request targets
+	static string GetTargetFactionKey(PQD_LoadoutRequest request, string adminFactionKey)
+	{
+		if (request.bulkFactionKey.IsEmpty())
+			return adminFactionKey;
+		
+		return request.bulkFactionKey;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void AddPlayerTarget(int playerId, array<ref PQD_BulkApplyTarget> targets)
+	{
+		IEntity entity = GetGame().GetPlayerManager().GetPlayerControlledEntity(playerId);
+		if (entity)
+			AddTarget(playerId, entity, targets);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! AI characters of a group, players in it are reached through their player group
+	protected static void AddGroupTargets(SCR_AIGroup group, array<ref PQD_BulkApplyTarget> targets)
+	{
+		array<AIAgent> agents = {};
+		group.GetAgents(agents);
+		
+		foreach (AIAgent agent : agents)
+		{
+			IEntity character = agent.GetControlledEntity();
+			if (!character)
+				continue;
+			
+			if (GetGame().GetPlayerManager().GetPlayerIdFromControlledEntity(character) > 0)
+				continue;
+			
+			AddTarget(0, character, targets);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void AddTarget(int playerId, IEntity entity, array<ref PQD_BulkApplyTarget> targets)
+	{
+		foreach (PQD_BulkApplyTarget existing : targets)
+		{
+			if (existing.entity == entity)
+				return;
+		}
+		
+		PQD_BulkApplyTarget target = new PQD_BulkApplyTarget();
+		target.playerId = playerId;
+		target.entity = entity;
+		targets.Insert(target);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void Enqueue(PQD_BulkApplyJob job)
+	{
+		job.targetCount = job.targets.Count();
+		s_aJobs.Insert(job);
+		
+		Print(string.Format("[PQD] BulkApply: Queued %1 targets from admin request %2", job.targetCount, job.request.Repr()), LogLevel.NORMAL);
+		
+		if (!s_bTicking)
+		{
+			s_bTicking = true;
+			GetGame().GetCallqueue().CallLater(Tick, 0, true);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void Tick()
+	{
+		int budget = PQD_KitApplyQueue.DEFAULT_APPLIES_PER_FRAME;
+		int budgetMs = PQD_KitApplyQueue.DEFAULT_FRAME_BUDGET_MS;
+		PQD_RespawnLoadoutComponent respawnComp = PQD_RespawnLoadoutComponent.GetInstance();
+		if (respawnComp)
+		{
+			budget = respawnComp.GetKitAppliesPerFrame();
+			budgetMs = respawnComp.GetKitApplyFrameBudgetMs();
+		}
+		
+		int frameStart = System.GetTickCount();
+		int processed;
+		
+		// At least one per frame so a slow apply cannot stall the queue
+		while (!s_aJobs.IsEmpty() && processed < budget)
+		{
+			if (processed > 0 && System.GetTickCount() - frameStart >= budgetMs)
+				break;
+			
+			PQD_BulkApplyJob job = s_aJobs[0];
+			if (job.targets.IsEmpty())
+			{
+				FinishJob(job);
+				s_aJobs.RemoveOrdered(0);
+				continue;
+			}
+			
+			PQD_BulkApplyTarget target = job.targets[0];
+			job.targets.RemoveOrdered(0);
+			processed++;
+			
+			ApplyToTarget(job, target);
+		}
+		
+		if (!s_aJobs.IsEmpty())
+			return;
+		
+		GetGame().GetCallqueue().Remove(Tick);
+		s_bTicking = false;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void ApplyToTarget(PQD_BulkApplyJob job, PQD_BulkApplyTarget target)
+	{
+		IEntity entity = target.entity;
+		
+		// Players may have respawned since the request, use their current character
+		if (target.playerId > 0)
+			entity = GetGame().GetPlayerManager().GetPlayerControlledEntity(target.playerId);
+		
+		GameEntity character = GameEntity.Cast(entity);
+		CharacterControllerComponent controller;
+		if (character)
+			controller = CharacterControllerComponent.Cast(character.FindComponent(CharacterControllerComponent));
+		
+		if (!controller || controller.IsDead())
+		{
+			job.skippedCount++;
+			return;
+		}
+		
+		// Squads and picked characters can mix factions, each target has to match the kit
+		if (!job.kitFactionKey.IsEmpty())
+		{
+			string targetFactionKey = GetEntityFactionKey(character);
+			if (targetFactionKey != job.kitFactionKey)
+			{
+				Print(string.Format("[PQD] BulkApply: Skipping %1 of faction %2, loadout belongs to %3", character, targetFactionKey, job.kitFactionKey), LogLevel.WARNING);
+				job.skippedCount++;
+				return;
+			}
+		}
+		
+		bool success;
+		if (target.playerId > 0)
+		{
+			SCR_BaseGameMode gameMode = SCR_BaseGameMode.Cast(GetGame().GetGameMode());
+			success = gameMode && gameMode.PQD_ReplaceEntityWithLoadout(target.playerId, character, job.prefab, job.loadoutData, job.factionKey);
+		}
+		else
+		{
+			success = ReplaceAICharacter(character, job.prefab, job.loadoutData);
+		}
+		
+		if (success)
+			job.appliedCount++;
+		else
+			job.failedCount++;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Faction a character is affiliated with, empty if it has none
+	protected static string GetEntityFactionKey(IEntity entity)
+	{
+		FactionAffiliationComponent factionComponent = FactionAffiliationComponent.Cast(entity.FindComponent(FactionAffiliationComponent));
+		if (!factionComponent)
+			return string.Empty;
+		
+		Faction faction = factionComponent.GetAffiliatedFaction();
+		if (!faction)
+			return string.Empty;
+		
+		return faction.GetFactionKey();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Spawn the kit's character in place of an AI and hand it over to the same group
+	protected static bool ReplaceAICharacter(GameEntity oldEntity, ResourceName prefab, string loadoutData)
+	{
+		SCR_AIGroup group;
+		SCR_ChimeraAIAgent oldAgent = PQD_Helpers.FindAIAgent(oldEntity);
+		if (oldAgent)
+			group = SCR_AIGroup.Cast(oldAgent.GetParentGroup());
+		
+		EntitySpawnParams params = new EntitySpawnParams();
+		params.TransformMode = ETransformMode.WORLD;
+		oldEntity.GetWorldTransform(params.Transform);
+		params.Transform[3] = params.Transform[3] + (vector.Up * 0.05);
+		
+		IEntity newEntity = GetGame().SpawnEntityPrefabEx(prefab, false, GetGame().GetWorld(), params);
+		GameEntity newGameEntity = GameEntity.Cast(newEntity);
+		if (!newGameEntity)
+		{
+			if (newEntity)
+				RplComponent.DeleteRplEntity(newEntity, false);
+			
+			Print(string.Format("[PQD] BulkApply: Failed to spawn AI character %1", prefab), LogLevel.ERROR);
+			return false;
+		}
+		
+		if (!PQD_PlayerFactionLoadoutStorage.ApplyToCharacter(newGameEntity, loadoutData))
+		{
+			RplComponent.DeleteRplEntity(newEntity, false);
+			Print("[PQD] BulkApply: Failed to apply loadout to AI character", LogLevel.ERROR);
+			return false;
+		}
+		
+		if (group)
+			group.AddAIEntityToGroup(newEntity);
+		
+		RplComponent.DeleteRplEntity(oldEntity, false);
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void FinishJob(PQD_BulkApplyJob job)
+	{
+		string message = string.Format("Loadout applied to %1/%2 characters", job.appliedCount, job.targetCount);
+		if (job.skippedCount > 0)
+			message = string.Format("%1, %2 skipped", message, job.skippedCount);
+		if (job.failedCount > 0)
+			message = string.Format("%1, %2 failed", message, job.failedCount);
+		
+		Print(string.Format("[PQD] BulkApply: %1", message), LogLevel.NORMAL);
+		
+		// Admin may have left while the queue ran
+		if (job.requester)
+			job.requester.SendActionResponse(job.request, job.appliedCount > 0 && job.failedCount == 0, message);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetPendingTargetCount()
+	{
+		int count;
+		foreach (PQD_BulkApplyJob job : s_aJobs)
+		{
+			count += job.targets.Count();
+		}
+		
+		return count;
+	}
+}
@@ -8,9 +8,15 @@ sealed class PQD_Cache
 	private static PQD_Cache m_Instance;
 	static PQD_Cache GetInstance() { return m_Instance; }
 
+	// Storages of the edited character kept around, least recently used is dropped first
+	static const int MAX_CACHED_STORAGES = 256;
+	
+	// Storage components are weak references, entries of deleted or unreachable storages are pruned
 	private ref map<RplId, BaseInventoryStorageComponent> m_RplId_Storage = new map<RplId, BaseInventoryStorageComponent>();
 	private ref map<BaseInventoryStorageComponent, RplId> m_Storage_RplId = new map<BaseInventoryStorageComponent, RplId>();
 	private ref map<BaseInventoryStorageComponent, PQD_StorageType> m_Storage_StorageType = new map<BaseInventoryStorageComponent, PQD_StorageType>();
+	private ref array<BaseInventoryStorageComponent> m_aStorageOrder = {};
+	private IEntity m_EditedCharacter;
 	
 	// Cache all arsenal items
 	private ref array<SCR_ArsenalItem> m_ArsenalItems = {};
@@ -114,10 +120,19 @@ sealed class PQD_Cache
 	//------------------------------------------------------------------------------------------------
 	RplId GetStorageRplId(BaseInventoryStorageComponent comp)
 	{
+		if (!comp)
+			return RplId.Invalid();
+		
 		if (m_Storage_RplId.Contains(comp))
+		{
+			TouchStorage(comp);
 			return m_Storage_RplId.Get(comp);
+		}
 		
 		RplId rplId = Replication.FindId(comp);
+		if (!TrackStorage(comp))
+			return rplId;
+		
 		m_RplId_Storage.Set(rplId, comp);
 		m_Storage_RplId.Set(comp, rplId);
 
@@ -127,21 +142,143 @@ sealed class PQD_Cache
 	//------------------------------------------------------------------------------------------------
 	BaseInventoryStorageComponent GetStorageByRplId(RplId rplId)
 	{
-		return m_RplId_Storage.Get(rplId);
+		BaseInventoryStorageComponent comp = m_RplId_Storage.Get(rplId);
+		if (!comp)
+			return null;
+		
+		if (!IsStorageReachable(comp))
+		{
+			PruneStorages();
+			return null;
+		}
+		
+		TouchStorage(comp);
+		return comp;
 	}
 	
 	//------------------------------------------------------------------------------------------------
 	PQD_StorageType GetStorageType(BaseInventoryStorageComponent comp)
 	{
 		if (m_Storage_StorageType.Contains(comp))
+		{
+			TouchStorage(comp);
 			return m_Storage_StorageType.Get(comp);
+		}
 		
 		PQD_StorageType storageType = PQD_Helpers.GetStorageType(comp);
-		m_Storage_StorageType.Set(comp, storageType);
+		if (TrackStorage(comp))
+			m_Storage_StorageType.Set(comp, storageType);
 		
 		return storageType;
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Character whose storages are cached, storages not attached to it are dropped
+	void SetEditedCharacter(IEntity character)
+	{
+		m_EditedCharacter = character;
+		PruneStorages();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! A storage is worth caching while it exists and belongs to the edited character
+	protected bool IsStorageReachable(BaseInventoryStorageComponent comp)
+	{
+		if (!comp)
+			return false;
+		
+		IEntity owner = comp.GetOwner();
+		if (!owner || owner.IsDeleted())
+			return false;
+		
+		return !m_EditedCharacter || owner.GetRootParent() == m_EditedCharacter;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Add the storage to the usage order, false if it should not be cached
+	protected bool TrackStorage(BaseInventoryStorageComponent comp)
+	{
+		if (!IsStorageReachable(comp))
+			return false;
+		
+		if (m_aStorageOrder.Contains(comp))
+		{
+			TouchStorage(comp);
+			return true;
+		}
+		
+		if (m_aStorageOrder.Count() >= MAX_CACHED_STORAGES)
+			PruneStorages();
+		
+		if (m_aStorageOrder.Count() >= MAX_CACHED_STORAGES)
+			ForgetStorage(m_aStorageOrder[0]);
+		
+		m_aStorageOrder.Insert(comp);
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void TouchStorage(BaseInventoryStorageComponent comp)
+	{
+		int index = m_aStorageOrder.Find(comp);
+		if (index < 0 || index == m_aStorageOrder.Count() - 1)
+			return;
+		
+		m_aStorageOrder.RemoveOrdered(index);
+		m_aStorageOrder.Insert(comp);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void ForgetStorage(BaseInventoryStorageComponent comp)
+	{
+		RplId rplId;
+		if (m_Storage_RplId.Find(comp, rplId))
+			m_RplId_Storage.Remove(rplId);
+		
+		m_Storage_RplId.Remove(comp);
+		m_Storage_StorageType.Remove(comp);
+		m_aStorageOrder.RemoveItemOrdered(comp);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Rebuild the storage maps from the storages still reachable, deleted ones can no longer be used as keys
+	void PruneStorages()
+	{
+		map<RplId, BaseInventoryStorageComponent> rplIdStorage = new map<RplId, BaseInventoryStorageComponent>();
+		map<BaseInventoryStorageComponent, RplId> storageRplId = new map<BaseInventoryStorageComponent, RplId>();
+		map<BaseInventoryStorageComponent, PQD_StorageType> storageType = new map<BaseInventoryStorageComponent, PQD_StorageType>();
+		array<BaseInventoryStorageComponent> storageOrder = {};
+		
+		foreach (BaseInventoryStorageComponent comp : m_aStorageOrder)
+		{
+			if (!IsStorageReachable(comp))
+				continue;
+			
+			storageOrder.Insert(comp);
+			
+			RplId rplId;
+			if (m_Storage_RplId.Find(comp, rplId))
+			{
+				rplIdStorage.Set(rplId, comp);
+				storageRplId.Set(comp, rplId);
+			}
+			
+			PQD_StorageType type;
+			if (m_Storage_StorageType.Find(comp, type))
+				storageType.Set(comp, type);
+		}
+		
+		int pruned = m_aStorageOrder.Count() - storageOrder.Count();
+		
+		m_RplId_Storage = rplIdStorage;
+		m_Storage_RplId = storageRplId;
+		m_Storage_StorageType = storageType;
+		m_aStorageOrder = storageOrder;
+		
+		if (pruned > 0)
+			Print(string.Format("[PQD] Cache: Pruned %1 storages, %2 cached", pruned, m_aStorageOrder.Count()), LogLevel.DEBUG);
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	bool TryGetPrefabsFromCache(string cacheKey, out array<ResourceName> outValidPrefabs, out int outItems)
 	{
@@ -0,0 +1,200 @@
+// PQD Loadout Editor - Chunked Transfer
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Splits large server -> owner payloads into rate-limited chunks on the reliable channel
+
+//------------------------------------------------------------------------------------------------
+//! Payload queued on the server
+sealed class PQD_OutgoingPayload
+{
+	int payloadId;
+	PQD_PayloadKind kind;
+	string data;
+	int chunkCount;
+	int nextChunk;
+}
+
+//------------------------------------------------------------------------------------------------
+//! Server side chunk queue of one player controller
+sealed class PQD_ChunkedSender
+{
+	static const int CHUNK_SIZE = 4096;
+	static const int CHUNKS_PER_TICK = 2;
+	static const int TICK_MS = 50;
+	
+	protected PQD_PlayerControllerComponent m_Component;
+	protected ref array<ref PQD_OutgoingPayload> m_aQueue = {};
+	protected int m_iLastPayloadId;
+	protected bool m_bTicking;
+	
+	//------------------------------------------------------------------------------------------------
+	void PQD_ChunkedSender(PQD_PlayerControllerComponent component)
+	{
+		m_Component = component;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void ~PQD_ChunkedSender()
+	{
+		if (m_bTicking && GetGame())
+			GetGame().GetCallqueue().Remove(Tick);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Queue a payload, payloads are delivered in the order they were queued
+	//! except action responses, which overtake sync payloads that have not started yet
+	void Send(PQD_PayloadKind kind, string data)
+	{
+		m_iLastPayloadId++;
+		
+		PQD_OutgoingPayload payload = new PQD_OutgoingPayload();
+		payload.payloadId = m_iLastPayloadId;
+		payload.kind = kind;
+		payload.data = data;
+		payload.chunkCount = Math.Max(1, (data.Length() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+		
+		// Nothing queued ahead of it, a single chunk goes out right away
+		if (m_aQueue.IsEmpty() && payload.chunkCount == 1)
+		{
+			SendNextChunk(payload);
+			return;
+		}
+		
+		if (kind == PQD_PayloadKind.ACTION_RESPONSE)
+			m_aQueue.InsertAt(payload, GetResponseQueueIndex());
+		else
+			m_aQueue.Insert(payload);
+		
+		if (m_bTicking)
+			return;
+		
+		m_bTicking = true;
+		Tick();
+		GetGame().GetCallqueue().CallLater(Tick, TICK_MS, true);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Behind payloads already being sent and the results of earlier actions, ahead of the rest
+	protected int GetResponseQueueIndex()
+	{
+		for (int i = m_aQueue.Count() - 1; i >= 0; i--)
+		{
+			PQD_OutgoingPayload queued = m_aQueue[i];
+			if (queued.nextChunk > 0 || queued.kind == PQD_PayloadKind.ACTION_RESPONSE || queued.kind == PQD_PayloadKind.SLOT_UPDATE)
+				return i + 1;
+		}
+		
+		return 0;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void SendNextChunk(PQD_OutgoingPayload payload)
+	{
+		if (payload.nextChunk == 0)
+			m_Component.SendPayloadHeader(payload.payloadId, payload.kind, payload.chunkCount, payload.data.Length(), payload.data.Hash());
+		
+		int start = payload.nextChunk * CHUNK_SIZE;
+		int length = Math.Min(CHUNK_SIZE, payload.data.Length() - start);
+		m_Component.SendPayloadChunk(payload.payloadId, payload.nextChunk, payload.data.Substring(start, length));
+		
+		payload.nextChunk++;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetQueuedPayloadCount()
+	{
+		return m_aQueue.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void Tick()
+	{
+		int budget = CHUNKS_PER_TICK;
+		
+		while (budget > 0 && !m_aQueue.IsEmpty())
+		{
+			PQD_OutgoingPayload payload = m_aQueue[0];
+			SendNextChunk(payload);
+			budget--;
+			
+			if (payload.nextChunk >= payload.chunkCount)
+				m_aQueue.RemoveOrdered(0);
+		}
+		
+		if (!m_aQueue.IsEmpty())
+			return;
+		
+		GetGame().GetCallqueue().Remove(Tick);
+		m_bTicking = false;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//! Payload being reassembled on the client
+sealed class PQD_IncomingPayload
+{
+	PQD_PayloadKind kind;
+	int length;
+	int checksum;
+	int received;
+	ref array<string> chunks = {};
+}
+
+//------------------------------------------------------------------------------------------------
+//! Client side reassembly of chunked payloads
+sealed class PQD_ChunkedReceiver
+{
+	protected ref map<int, ref PQD_IncomingPayload> m_mPayloads = new map<int, ref PQD_IncomingPayload>();
+	
+	//------------------------------------------------------------------------------------------------
+	void OnHeader(int payloadId, PQD_PayloadKind kind, int chunkCount, int length, int checksum)
+	{
+		PQD_IncomingPayload payload = new PQD_IncomingPayload();
+		payload.kind = kind;
+		payload.length = length;
+		payload.checksum = checksum;
+		payload.chunks.Resize(chunkCount);
+		m_mPayloads.Set(payloadId, payload);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Store a chunk, returns true once the payload is complete and passed the integrity check
+	bool OnChunk(int payloadId, int index, string chunk, out PQD_PayloadKind kind, out string data)
+	{
+		PQD_IncomingPayload payload = m_mPayloads.Get(payloadId);
+		if (!payload)
+		{
+			Print(string.Format("[PQD] Chunk %1 for unknown payload #%2", index, payloadId), LogLevel.WARNING);
+			return false;
+		}
+		
+		if (!payload.chunks.IsIndexValid(index))
+		{
+			Print(string.Format("[PQD] Chunk %1 out of range for payload #%2", index, payloadId), LogLevel.WARNING);
+			return false;
+		}
+		
+		payload.chunks[index] = chunk;
+		payload.received++;
+		
+		if (payload.received < payload.chunks.Count())
+			return false;
+		
+		m_mPayloads.Remove(payloadId);
+		
+		foreach (string part : payload.chunks)
+		{
+			data += part;
+		}
+		
+		if (data.Length() != payload.length || data.Hash() != payload.checksum)
+		{
+			Print(string.Format("[PQD] Payload #%1 failed integrity check (%2/%3 bytes)", payloadId, data.Length(), payload.length), LogLevel.ERROR);
+			data = "";
+			return false;
+		}
+		
+		kind = payload.kind;
+		return true;
+	}
+}
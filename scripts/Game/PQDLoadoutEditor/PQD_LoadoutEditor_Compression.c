@@ -0,0 +1,141 @@
+// PQD Loadout Editor - Loadout Data Compression
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Static dictionary substitution for serialized loadout strings (network payloads and save files)
+
+//------------------------------------------------------------------------------------------------
+//! Replaces frequent substrings of serialized loadouts with 3 character codes
+//! Format: PREFIX + data where "``" is a literal backtick and "`X`" is dictionary entry X
+class PQD_LoadoutCompression
+{
+	// Bump when the dictionary changes in any way other than appending
+	static const string PREFIX = "~z1~";
+	
+	protected static const string CODE_ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+	
+	// Entries must not contain a backtick - longer entries go before entries they contain
+	// Append only, at most CODE_ALPHABET.Length() entries
+	protected static ref array<string> s_aDictionary = {
+		"SCR_CharacterInventoryStorageComponent",
+		"SCR_UniversalInventoryStorageComponent",
+		"CharacterInventoryStorageComponent",
+		"WeaponAttachmentsStorageComponent",
+		"EquipedLoadoutStorageComponent",
+		"EquipedWeaponStorageComponent",
+		"SCR_EquipmentStorageComponent",
+		"BaseInventoryStorageComponent",
+		"ClothNodeStorageComponent",
+		"InventoryStorageComponent",
+		"StorageComponent",
+		"{\"storages\":[",
+		"{\"id\":\"",
+		"\",\"slots\":{",
+		"{\"prefab\":\"",
+		"\"prefab\":\"",
+		"Prefabs/Characters/",
+		"Prefabs/Weapons/",
+		"Prefabs/Items/",
+		"Attachments/",
+		"Magazines/",
+		"Equipment/",
+		"Backpacks/",
+		"Uniforms/",
+		"Headgear/",
+		"Footwear/",
+		"Handwear/",
+		"Grenades/",
+		"Medicine/",
+		"Handguns/",
+		"Jackets/",
+		"Rifles/",
+		"Optics/",
+		"Pants/",
+		"Vests/",
+		"Magazine_",
+		"Jacket_",
+		"Pants_",
+		"Vest_",
+		".et\"",
+		"\"}},",
+		"\"},\"",
+		"\":{"
+	};
+	
+	//------------------------------------------------------------------------------------------------
+	static bool IsCompressed(string data)
+	{
+		return data.StartsWith(PREFIX);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Compress serialized loadout data, returns the input if compression does not make it shorter
+	static string Compress(string data)
+	{
+		if (data.IsEmpty() || IsCompressed(data))
+			return data;
+		
+		// Entries never contain a backtick, so no match can span an escape or a code
+		string result = data;
+		result.Replace("`", "``");
+		
+		foreach (int i, string entry : s_aDictionary)
+		{
+			result.Replace(entry, "`" + CODE_ALPHABET.Get(i) + "`");
+		}
+		
+		if (result.Length() + PREFIX.Length() >= data.Length())
+			return data;
+		
+		return PREFIX + result;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Inverse of Compress, uncompressed input is returned unchanged
+	static string Decompress(string data)
+	{
+		if (!IsCompressed(data))
+			return data;
+		
+		int length = data.Length();
+		int copyFrom = PREFIX.Length();
+		string result;
+		
+		int marker = data.IndexOfFrom(copyFrom, "`");
+		while (marker != -1)
+		{
+			if (marker + 1 >= length)
+				break;
+			
+			result += data.Substring(copyFrom, marker - copyFrom);
+			
+			string code = data.Get(marker + 1);
+			if (code == "`")
+			{
+				result += "`";
+				copyFrom = marker + 2;
+			}
+			else
+			{
+				int index = CODE_ALPHABET.IndexOf(code);
+				if (!s_aDictionary.IsIndexValid(index) || marker + 2 >= length || data.Get(marker + 2) != "`")
+				{
+					Print(string.Format("[PQD] LoadoutCompression: Invalid code at %1", marker), LogLevel.ERROR);
+					return "";
+				}
+				
+				result += s_aDictionary[index];
+				copyFrom = marker + 3;
+			}
+			
+			if (copyFrom >= length)
+				break;
+			
+			marker = data.IndexOfFrom(copyFrom, "`");
+		}
+		
+		if (copyFrom < length)
+			result += data.Substring(copyFrom, length - copyFrom);
+		
+		return result;
+	}
+}
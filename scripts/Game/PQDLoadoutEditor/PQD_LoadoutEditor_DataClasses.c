@@ -116,6 +116,18 @@ sealed class PQD_EditorOptionData : PQD_SlotChoice
 	bool optionEnabled = true;
 }
 
+//------------------------------------------------------------------------------------------------
+// Locally predicted slot content while a storage request is in flight
+sealed class PQD_SlotPrediction
+{
+	int sequenceId;
+	RplId storageRplId;
+	int storageSlotId;
+	ResourceName prefab;     // Empty = removed
+	int sentAt;              // Tick count when the request was sent
+	bool expired;            // No response in time, the slot shows the replicated state
+}
+
 //------------------------------------------------------------------------------------------------
 // Item listing helper class
 sealed class PQD_ItemListing
@@ -148,6 +160,7 @@ sealed class PQD_PlayerLoadout
 	// Requirements and cost
 	string required_rank;        // Highest rank required for items in loadout
 	float supplyCost;            // Total supply cost of the loadout
+	int supplyCostVersion;       // PQD_LoadoutCostCache price table version supplyCost was computed with
 	
 	// Slot identification
 	int slotId;
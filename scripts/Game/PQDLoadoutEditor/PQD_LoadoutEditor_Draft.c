@@ -0,0 +1,182 @@
+// PQD Loadout Editor - Draft Editing
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Client-side pending slot changes, committed to the server as one storage batch
+
+//------------------------------------------------------------------------------------------------
+//! One pending slot change
+sealed class PQD_DraftChange
+{
+	RplId storageRplId;
+	int storageSlotId;
+	ResourceName originalPrefab;
+	ResourceName prefab; // Empty = remove item
+}
+
+//------------------------------------------------------------------------------------------------
+//! Set of pending slot changes - only the latest choice per slot is kept
+sealed class PQD_LoadoutDraft
+{
+	// Map: "storageRplId_slotId" -> pending change
+	protected ref map<string, ref PQD_DraftChange> m_mChanges = new map<string, ref PQD_DraftChange>();
+
+	// Keys in the order slots were first edited, so containers are processed before their contents
+	protected ref array<string> m_aOrder = {};
+
+	// Keys sent with the last commit, aligned with the batch operations
+	protected ref array<string> m_aCommittedKeys = {};
+
+	//------------------------------------------------------------------------------------------------
+	protected static string GetKey(RplId storageRplId, int storageSlotId)
+	{
+		return string.Format("%1_%2", storageRplId, storageSlotId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Record a choice for a slot, choosing the original item again drops the change
+	void SetChange(RplId storageRplId, int storageSlotId, ResourceName originalPrefab, ResourceName prefab)
+	{
+		string key = GetKey(storageRplId, storageSlotId);
+
+		PQD_DraftChange change = m_mChanges.Get(key);
+		if (change)
+			originalPrefab = change.originalPrefab;
+
+		if (prefab == originalPrefab)
+		{
+			m_mChanges.Remove(key);
+			m_aOrder.RemoveItemOrdered(key);
+			return;
+		}
+
+		if (!change)
+		{
+			change = new PQD_DraftChange();
+			change.storageRplId = storageRplId;
+			change.storageSlotId = storageSlotId;
+			change.originalPrefab = originalPrefab;
+			m_mChanges.Set(key, change);
+			m_aOrder.Insert(key);
+		}
+
+		change.prefab = prefab;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool GetChange(RplId storageRplId, int storageSlotId, out ResourceName prefab)
+	{
+		PQD_DraftChange change = m_mChanges.Get(GetKey(storageRplId, storageSlotId));
+		if (!change)
+			return false;
+
+		prefab = change.prefab;
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	bool HasChanges()
+	{
+		return !m_mChanges.IsEmpty();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	int Count()
+	{
+		return m_mChanges.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	void Clear()
+	{
+		m_mChanges.Clear();
+		m_aOrder.Clear();
+		m_aCommittedKeys.Clear();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Supply cost of every item the draft would insert
+	float GetTotalCost(PQD_Cache cache)
+	{
+		float total;
+		float cost;
+		SCR_ECharacterRank rank;
+
+		foreach (string key, PQD_DraftChange change : m_mChanges)
+		{
+			if (change.prefab.IsEmpty())
+				continue;
+
+			cache.GetArsenalItemCostAndRank(change.prefab, cost, rank);
+			total += cost;
+		}
+
+		return total;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Supply cost of the pending change for one slot, 0 if the slot is not drafted
+	float GetSlotCost(PQD_Cache cache, RplId storageRplId, int storageSlotId)
+	{
+		PQD_DraftChange change = m_mChanges.Get(GetKey(storageRplId, storageSlotId));
+		if (!change || change.prefab.IsEmpty())
+			return 0;
+
+		float cost;
+		SCR_ECharacterRank rank;
+		cache.GetArsenalItemCostAndRank(change.prefab, cost, rank);
+		return cost;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Build the minimal diff as one storage batch, validated as a whole before it runs
+	PQD_StorageBatchRequest BuildCommitRequest(RplId arsenalEntityRplId)
+	{
+		PQD_StorageBatchRequest batch = new PQD_StorageBatchRequest();
+		batch.arsenalEntityRplId = arsenalEntityRplId;
+		batch.validateAll = true;
+
+		m_aCommittedKeys.Clear();
+
+		foreach (string key : m_aOrder)
+		{
+			PQD_DraftChange change = m_mChanges.Get(key);
+			if (!change)
+				continue;
+
+			PQD_StorageRequest operation = new PQD_StorageRequest();
+			operation.arsenalEntityRplId = arsenalEntityRplId;
+			operation.storageRplId = change.storageRplId;
+			operation.storageSlotId = change.storageSlotId;
+			operation.prefab = change.prefab;
+
+			if (change.prefab.IsEmpty())
+				operation.actionType = PQD_ActionType.REMOVE_ITEM;
+			else
+				operation.actionType = PQD_ActionType.REPLACE_ITEM;
+
+			batch.operations.Insert(operation);
+			m_aCommittedKeys.Insert(key);
+		}
+
+		return batch;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Drop every change the server applied, failed ones stay in the draft
+	void ApplyCommitResults(array<ref PQD_StorageOperationResult> results)
+	{
+		if (!results)
+			return;
+
+		foreach (int i, string key : m_aCommittedKeys)
+		{
+			if (!results.IsIndexValid(i) || !results[i] || !results[i].success)
+				continue;
+
+			m_mChanges.Remove(key);
+			m_aOrder.RemoveItemOrdered(key);
+		}
+
+		m_aCommittedKeys.Clear();
+	}
+}
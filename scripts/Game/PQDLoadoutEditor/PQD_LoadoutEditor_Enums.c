@@ -104,7 +104,56 @@ enum PQD_ActionType
 	SET_AI_LOADOUT_ADMIN,
 	CLEAR_LOADOUT_ADMIN,
 	CHANGE_VISUAL_IDENTITY,
-	CHANGE_SOUND_IDENTITY
+	CHANGE_SOUND_IDENTITY,
+	STORAGE_BATCH
+}
+
+//------------------------------------------------------------------------------------------------
+// Characters targeted by a bulk admin loadout apply (SET_AI_LOADOUT_ADMIN)
+enum PQD_BulkApplyScope
+{
+	SQUAD,		// Players and AI of the admin's group
+	FACTION,	// Every player of a faction
+	ENTITIES	// Characters or AI groups listed by RplId
+}
+
+//------------------------------------------------------------------------------------------------
+// Request classes with separate server-side rate limits
+enum PQD_RequestClass
+{
+	STORAGE,		// Single item add/remove/replace, identity changes
+	STORAGE_BATCH,	// Multiple storage operations in one request
+	LOADOUT_READ,	// Loadout listings
+	LOADOUT_WRITE	// Save, clear and apply - file IO or character respawn
+}
+
+//------------------------------------------------------------------------------------------------
+// Content of a chunked server -> owner payload
+enum PQD_PayloadKind
+{
+	ACTION_RESPONSE,	// Serialized PQD_NetworkResponse
+	VALID_SLOTS,		// Valid slot indices per faction, sent before the loadout data
+	LOADOUT_DATA,		// One PQD_LoadoutDataTransfer
+	ADMIN_LOADOUTS,		// Server loadout metadata for the owner
+	SLOT_UPDATE,		// Saved or cleared slot (no loadout data when cleared) and the faction's new version
+	PREFAB_DICTIONARY	// Exported PQD_PrefabDictionary
+}
+
+//------------------------------------------------------------------------------------------------
+// Optional features announced by the client, bit flags
+enum PQD_ClientCapability
+{
+	LOADOUT_COMPRESSION = 1	// Understands PQD_LoadoutCompression in loadout payloads
+}
+
+//------------------------------------------------------------------------------------------------
+// Conditions a spawned character must meet before a loadout step runs, bit flags
+enum PQD_ReadinessCondition
+{
+	ENTITY_REPLICATED = 1,	// Registered with replication
+	CONTROLLER_READY = 2,	// Has a living character controller
+	INVENTORY_READY = 4,	// Inventory manager has its storages
+	PLAYER_CONTROLLED = 8	// Controlled by a player
 }
 
 //------------------------------------------------------------------------------------------------
@@ -31,6 +31,18 @@ class PQD_GameModeComponent : SCR_BaseGameModeComponent
 	[Attribute("1", UIWidgets.CheckBox, "Enable rank restrictions")]
 	protected bool m_bEnableRankRestrictions;
 	
+	[Attribute("0", UIWidgets.CheckBox, "Compress loadout data in save files (~z1~ format, older mod versions and external tools cannot read it)")]
+	protected bool m_bCompressStoredLoadouts;
+	
+	[Attribute("0", UIWidgets.CheckBox, "Apply loadouts to the current character when the base prefab matches, instead of spawning a new one")]
+	protected bool m_bApplyLoadoutsInPlace;
+	
+	[Attribute("2", UIWidgets.Slider, "Maximum number of initial loadout syncs processed per frame", "1 20 1")]
+	protected int m_iInitialSyncsPerFrame;
+	
+	[Attribute("3000", UIWidgets.Slider, "Random delay spread for initial loadout syncs once more players wait than a frame can sync (ms)", "0 30000 100")]
+	protected int m_iInitialSyncJitterMs;
+	
 	protected static PQD_GameModeComponent s_Instance;
 	
 	//------------------------------------------------------------------------------------------------
@@ -91,6 +103,30 @@ class PQD_GameModeComponent : SCR_BaseGameModeComponent
 		return m_bEnableRankRestrictions;
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	bool IsStoredLoadoutCompressionEnabled()
+	{
+		return m_bCompressStoredLoadouts;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsInPlaceLoadoutApplyEnabled()
+	{
+		return m_bApplyLoadoutsInPlace;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetInitialSyncsPerFrame()
+	{
+		return m_iInitialSyncsPerFrame;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetInitialSyncJitterMs()
+	{
+		return m_iInitialSyncJitterMs;
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	//! Validate if a player can use a specific loadout
 	bool CanPlayerUseLoadout(int playerId, PQD_PlayerLoadout loadout)
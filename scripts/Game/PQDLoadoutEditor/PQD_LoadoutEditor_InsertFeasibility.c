@@ -0,0 +1,97 @@
+// PQD Loadout Editor - Insert Feasibility Memo
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Server-side memo of item inserts known to fail, checked before spawning the item
+
+//------------------------------------------------------------------------------------------------
+//! Failed storage searches keyed by (storage prefab, storage component, item prefab)
+//! Only searches in an empty storage are recorded, their outcome does not depend on other items
+//! so the entry is shared by everyone. Inserts into a slot can fail because of other gear of the
+//! character and are never memoized. Failures expire after a while in case a mod changes the storage.
+class PQD_InsertFeasibilityMemo
+{
+	static const int MAX_ENTRIES = 2048;
+	static const int INFEASIBLE_TTL_MS = 300000;
+	
+	// Key -> tick the failure was recorded at
+	protected static ref map<string, int> s_mRecordedAt = new map<string, int>();
+	
+	// Metrics
+	protected static int s_iRejectedCount;
+	protected static int s_iRecordedFailureCount;
+	
+	//------------------------------------------------------------------------------------------------
+	//! Memo key, empty if the storage owner has no prefab
+	static string GetKey(BaseInventoryStorageComponent storage, ResourceName itemPrefab)
+	{
+		if (!storage || itemPrefab.IsEmpty())
+			return string.Empty;
+		
+		ResourceName ownerPrefab;
+		if (!PQD_Helpers.GetResourceNameFromEntity(storage.GetOwner(), ownerPrefab) || ownerPrefab.IsEmpty())
+			return string.Empty;
+		
+		return string.Format("%1|%2|%3", ownerPrefab, storage.Type(), itemPrefab);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! True if the same insert failed recently, the request can be rejected without spawning the item
+	static bool IsKnownInfeasible(string key)
+	{
+		if (key.IsEmpty())
+			return false;
+		
+		int recordedAt;
+		if (!s_mRecordedAt.Find(key, recordedAt))
+			return false;
+		
+		if (System.GetTickCount() - recordedAt > INFEASIBLE_TTL_MS)
+		{
+			s_mRecordedAt.Remove(key);
+			return false;
+		}
+		
+		s_iRejectedCount++;
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void RecordFailure(string key)
+	{
+		if (key.IsEmpty())
+			return;
+		
+		// Entries are cheap to relearn, start over instead of tracking usage
+		if (!s_mRecordedAt.Contains(key) && s_mRecordedAt.Count() >= MAX_ENTRIES)
+			Clear();
+		
+		s_iRecordedFailureCount++;
+		s_mRecordedAt.Set(key, System.GetTickCount());
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void Clear()
+	{
+		s_mRecordedAt.Clear();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Requests rejected from the memo, each one a temporary entity not spawned
+	static int GetRejectedCount()
+	{
+		return s_iRejectedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetRecordedFailureCount()
+	{
+		return s_iRecordedFailureCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void ResetMetrics()
+	{
+		s_iRejectedCount = 0;
+		s_iRecordedFailureCount = 0;
+	}
+}
@@ -0,0 +1,170 @@
+// PQD Loadout Editor - Respawn Kit Apply Queue
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Server-side queue spreading respawn kit replacements of a deploy wave over several frames
+
+//------------------------------------------------------------------------------------------------
+//! One spawned character waiting for its kit
+sealed class PQD_KitApplyTicket
+{
+	SCR_BaseGameMode gameMode;
+	int playerId;
+	IEntity entity;
+	int spawnTime;
+	int enqueueTime;
+}
+
+//------------------------------------------------------------------------------------------------
+//! Static queue processed under a per-frame entity and time budget, oldest spawn first
+class PQD_KitApplyQueue
+{
+	// Defaults used when the game mode has no PQD_RespawnLoadoutComponent
+	static const int DEFAULT_APPLIES_PER_FRAME = 1;
+	static const int DEFAULT_FRAME_BUDGET_MS = 4;
+	
+	protected static ref array<ref PQD_KitApplyTicket> s_aQueue = {};
+	protected static bool s_bTicking;
+	
+	// Metrics
+	protected static int s_iPeakQueueDepth;
+	protected static int s_iProcessedCount;
+	protected static int s_iTotalWaitMs;
+	protected static int s_iMaxWaitMs;
+	
+	//------------------------------------------------------------------------------------------------
+	//! Queue a kit replacement, a player already in the queue keeps their original place
+	static void Enqueue(SCR_BaseGameMode gameMode, int playerId, IEntity entity, int spawnTime)
+	{
+		foreach (PQD_KitApplyTicket queued : s_aQueue)
+		{
+			if (queued.playerId != playerId)
+				continue;
+			
+			queued.entity = entity;
+			return;
+		}
+		
+		PQD_KitApplyTicket ticket = new PQD_KitApplyTicket();
+		ticket.gameMode = gameMode;
+		ticket.playerId = playerId;
+		ticket.entity = entity;
+		ticket.spawnTime = spawnTime;
+		ticket.enqueueTime = System.GetTickCount();
+		
+		s_aQueue.Insert(ticket);
+		s_iPeakQueueDepth = Math.Max(s_iPeakQueueDepth, s_aQueue.Count());
+		
+		if (!s_bTicking)
+		{
+			s_bTicking = true;
+			GetGame().GetCallqueue().CallLater(Tick, 0, true);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void Tick()
+	{
+		int budget = DEFAULT_APPLIES_PER_FRAME;
+		int budgetMs = DEFAULT_FRAME_BUDGET_MS;
+		PQD_RespawnLoadoutComponent respawnComp = PQD_RespawnLoadoutComponent.GetInstance();
+		if (respawnComp)
+		{
+			budget = respawnComp.GetKitAppliesPerFrame();
+			budgetMs = respawnComp.GetKitApplyFrameBudgetMs();
+		}
+		
+		int frameStart = System.GetTickCount();
+		int processed;
+		
+		// At least one per frame so a slow apply cannot stall the queue
+		while (!s_aQueue.IsEmpty() && processed < budget)
+		{
+			if (processed > 0 && System.GetTickCount() - frameStart >= budgetMs)
+				break;
+			
+			PQD_KitApplyTicket ticket = PopOldest();
+			
+			// Player died, left or already got another character
+			if (!ticket.gameMode || !PQD_ReadinessScheduler.CheckConditions(ticket.entity, SCR_BaseGameMode.PQD_FALLBACK_READINESS))
+			{
+				PQD_PendingLoadoutManager.RemovePendingLoadout(ticket.playerId);
+				continue;
+			}
+			
+			int waitMs = frameStart - ticket.enqueueTime;
+			s_iTotalWaitMs += waitMs;
+			s_iMaxWaitMs = Math.Max(s_iMaxWaitMs, waitMs);
+			s_iProcessedCount++;
+			processed++;
+			
+			ticket.gameMode.PQD_ApplyFallbackLoadout(ticket.playerId, ticket.entity, ticket.spawnTime);
+		}
+		
+		if (!s_aQueue.IsEmpty())
+			return;
+		
+		GetGame().GetCallqueue().Remove(Tick);
+		s_bTicking = false;
+		
+		Print(string.Format("[PQD] KitApplyQueue: Queue drained - %1 processed, peak depth %2, avg wait %3 ms, max wait %4 ms",
+			s_iProcessedCount, s_iPeakQueueDepth, GetAverageWaitMs(), s_iMaxWaitMs), LogLevel.DEBUG);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Remove and return the ticket with the earliest spawn, retries keep their original spawn time
+	protected static PQD_KitApplyTicket PopOldest()
+	{
+		int oldestIndex;
+		for (int i = 1, count = s_aQueue.Count(); i < count; i++)
+		{
+			if (s_aQueue[i].spawnTime < s_aQueue[oldestIndex].spawnTime)
+				oldestIndex = i;
+		}
+		
+		PQD_KitApplyTicket ticket = s_aQueue[oldestIndex];
+		s_aQueue.RemoveOrdered(oldestIndex);
+		return ticket;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetQueueDepth()
+	{
+		return s_aQueue.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetPeakQueueDepth()
+	{
+		return s_iPeakQueueDepth;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetProcessedCount()
+	{
+		return s_iProcessedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetAverageWaitMs()
+	{
+		if (s_iProcessedCount == 0)
+			return 0;
+		
+		return s_iTotalWaitMs / s_iProcessedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetMaxWaitMs()
+	{
+		return s_iMaxWaitMs;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void ResetMetrics()
+	{
+		s_iPeakQueueDepth = s_aQueue.Count();
+		s_iProcessedCount = 0;
+		s_iTotalWaitMs = 0;
+		s_iMaxWaitMs = 0;
+	}
+}
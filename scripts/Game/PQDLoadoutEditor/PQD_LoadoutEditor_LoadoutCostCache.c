@@ -0,0 +1,208 @@
+// PQD Loadout Editor - Loadout Cost Cache
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Supply cost of serialized loadouts per faction and cost type, recomputed when prices change between sessions
+
+//------------------------------------------------------------------------------------------------
+//! Cost of one loadout for one faction and cost type, valid for the price table version it was computed with
+sealed class PQD_LoadoutCostEntry
+{
+	string loadoutData;
+	FactionKey factionKey;
+	SCR_EArsenalSupplyCostType costType;
+	int priceTableVersion;
+	float cost;
+}
+
+//------------------------------------------------------------------------------------------------
+//! Static cache so a loadout is only run through ComputeSuppliesCost once per price table version
+//! The version is a hash of the arsenal item catalogs, so it stays the same across restarts until
+//! the catalog configs change
+class PQD_LoadoutCostCache
+{
+	// Costs kept around, least recently used is dropped first
+	static const int MAX_CACHED_COSTS = 256;
+	
+	protected static ref map<string, ref PQD_LoadoutCostEntry> s_mCache = new map<string, ref PQD_LoadoutCostEntry>();
+	protected static ref array<string> s_aCacheOrder = {};
+	protected static int s_iPriceTableVersion; // 0 until hashed, see GetPriceTableVersion
+	
+	// Metrics
+	protected static int s_iHitCount;
+	protected static int s_iMissCount;
+	
+	//------------------------------------------------------------------------------------------------
+	//! Supply cost of a serialized loadout, computed only when not cached for the current prices
+	//! \return False if the loadout cannot be read
+	static bool GetCost(string loadoutData, SCR_Faction faction, SCR_EArsenalSupplyCostType costType, out float cost)
+	{
+		if (!faction || loadoutData.IsEmpty())
+			return false;
+		
+		string key = GetKey(loadoutData, faction.GetFactionKey(), costType);
+		
+		PQD_LoadoutCostEntry entry = s_mCache.Get(key);
+		if (entry && entry.loadoutData == loadoutData && entry.priceTableVersion == GetPriceTableVersion())
+		{
+			s_iHitCount++;
+			Touch(key);
+			cost = entry.cost;
+			return true;
+		}
+		
+		s_iMissCount++;
+		if (!Compute(loadoutData, faction, costType, cost))
+			return false;
+		
+		if (!s_mCache.Contains(key) && s_mCache.Count() >= MAX_CACHED_COSTS)
+		{
+			s_mCache.Remove(s_aCacheOrder[0]);
+			s_aCacheOrder.RemoveOrdered(0);
+		}
+		
+		entry = new PQD_LoadoutCostEntry();
+		entry.loadoutData = loadoutData;
+		entry.factionKey = faction.GetFactionKey();
+		entry.costType = costType;
+		entry.priceTableVersion = GetPriceTableVersion();
+		entry.cost = cost;
+		
+		s_mCache.Set(key, entry);
+		Touch(key);
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Run the vanilla supply cost computation over the whole loadout
+	static bool Compute(string loadoutData, SCR_Faction faction, SCR_EArsenalSupplyCostType costType, out float cost)
+	{
+		if (!faction)
+			return false;
+		
+		SCR_ArsenalPlayerLoadout playerLoadout = new SCR_ArsenalPlayerLoadout;
+		playerLoadout.loadout = loadoutData;
+		playerLoadout.suppliesCost = 0.0;
+		
+		SCR_JsonLoadContext context = new SCR_JsonLoadContext(false);
+		if (!context.ImportFromString(playerLoadout.loadout))
+			return false;
+		
+		SCR_PlayerArsenalLoadout.ComputeSuppliesCost(context, faction, playerLoadout, costType);
+		
+		cost = playerLoadout.suppliesCost;
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Hash of every arsenal item price and rank, computed once per session
+	//! Versions are stored with saved loadouts, a stored cost stays valid across restarts as long as
+	//! the catalogs are unchanged
+	static int GetPriceTableVersion()
+	{
+		if (s_iPriceTableVersion != 0)
+			return s_iPriceTableVersion;
+		
+		array<int> costTypes = {};
+		SCR_Enum.GetEnumValues(SCR_EArsenalSupplyCostType, costTypes);
+		
+		int version = 17;
+		
+		SCR_EntityCatalogManagerComponent entityCatalogManager = SCR_EntityCatalogManagerComponent.GetInstance();
+		if (entityCatalogManager)
+			version = HashCatalog(version, entityCatalogManager.GetEntityCatalogOfType(EEntityCatalogType.ITEM), costTypes);
+		
+		FactionManager factionManager = GetGame().GetFactionManager();
+		if (factionManager)
+		{
+			array<Faction> factions = {};
+			factionManager.GetFactionsList(factions);
+			
+			foreach (Faction faction : factions)
+			{
+				SCR_Faction scrFaction = SCR_Faction.Cast(faction);
+				if (!scrFaction)
+					continue;
+				
+				version = version * 31 + scrFaction.GetFactionKey().Hash();
+				version = HashCatalog(version, scrFaction.GetFactionEntityCatalogOfType(EEntityCatalogType.ITEM), costTypes);
+			}
+		}
+		
+		// 0 is "not hashed yet" and the value of loadouts saved before versions were stored
+		if (version == 0)
+			version = 1;
+		
+		s_iPriceTableVersion = version;
+		Print(string.Format("[PQD] LoadoutCostCache: Price table version %1", s_iPriceTableVersion), LogLevel.DEBUG);
+		return s_iPriceTableVersion;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static int HashCatalog(int version, SCR_EntityCatalog catalog, array<int> costTypes)
+	{
+		if (!catalog)
+			return version;
+		
+		array<SCR_EntityCatalogEntry> entries = {};
+		catalog.GetEntityList(entries);
+		
+		foreach (SCR_EntityCatalogEntry entry : entries)
+		{
+			if (!entry)
+				continue;
+			
+			SCR_ArsenalItem arsenalItem = SCR_ArsenalItem.Cast(entry.GetEntityDataOfType(SCR_ArsenalItem));
+			if (!arsenalItem)
+				continue;
+			
+			version = version * 31 + entry.GetPrefab().Hash();
+			version = version * 31 + arsenalItem.GetRequiredRank();
+			
+			foreach (int costType : costTypes)
+			{
+				version = version * 31 + Math.Round(arsenalItem.GetSupplyCost(costType) * 100);
+			}
+		}
+		
+		return version;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void ClearCache()
+	{
+		s_mCache.Clear();
+		s_aCacheOrder.Clear();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static string GetKey(string loadoutData, FactionKey factionKey, SCR_EArsenalSupplyCostType costType)
+	{
+		return string.Format("%1:%2:%3", loadoutData.Hash(), factionKey, costType);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void Touch(string key)
+	{
+		s_aCacheOrder.RemoveItemOrdered(key);
+		s_aCacheOrder.Insert(key);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetHitCount()
+	{
+		return s_iHitCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetMissCount()
+	{
+		return s_iMissCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void ResetMetrics()
+	{
+		s_iHitCount = 0;
+		s_iMissCount = 0;
+	}
+}
@@ -0,0 +1,239 @@
+// PQD Loadout Editor - Loadout Slot Diff
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Compares a saved loadout with a live character so it can be applied in place
+
+//------------------------------------------------------------------------------------------------
+//! Diffs a saved loadout against the character per slot and turns the differences into storage operations
+//! Both sides are compared as PQD_ParsedLoadout, an item of the same prefab is kept and its storages
+//! are diffed in turn, at any depth
+class PQD_LoadoutSlotDiff
+{
+	//------------------------------------------------------------------------------------------------
+	//! Build the operations that turn the character into the saved loadout
+	//! Returns false when the loadout cannot be applied in place and the character has to be replaced
+	static bool BuildOperations(IEntity character, string loadoutData, RplId arsenalEntityRplId, notnull array<ref PQD_StorageRequest> operations)
+	{
+		PQD_ParsedLoadout saved = PQD_ParsedLoadout.Get(loadoutData);
+		if (!saved)
+			return false;
+
+		string currentData;
+		if (!PQD_PlayerFactionLoadoutStorage.SerializeCharacter(character, currentData))
+			return false;
+
+		// Live character, not worth a place in the shared cache
+		PQD_ParsedLoadout current = PQD_ParsedLoadout.Parse(currentData);
+		if (!current)
+			return false;
+
+		array<ref PQD_StorageRequest> removals = {};
+		array<ref PQD_StorageRequest> replacements = {};
+		if (!DiffStorages(character, saved.storages, current.storages, arsenalEntityRplId, removals, replacements))
+			return false;
+
+		// Removals first so replacements have room to fit
+		foreach (PQD_StorageRequest removal : removals)
+		{
+			operations.Insert(removal);
+		}
+
+		foreach (PQD_StorageRequest replacement : replacements)
+		{
+			operations.Insert(replacement);
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Diff the storages of one entity, savedStorages and currentStorages are its saved and serialized storages
+	protected static bool DiffStorages(IEntity entity, array<ref PQD_ParsedLoadoutStorage> savedStorages, array<ref PQD_ParsedLoadoutStorage> currentStorages, RplId arsenalEntityRplId, notnull array<ref PQD_StorageRequest> removals, notnull array<ref PQD_StorageRequest> replacements)
+	{
+		// Storages are matched by type, two of the same type cannot be told apart
+		if (HasDuplicateStorageIds(savedStorages) || HasDuplicateStorageIds(currentStorages))
+			return false;
+
+		array<BaseInventoryStorageComponent> storages = {};
+		FindEntityStorages(entity, storages);
+
+		// Items the saved loadout does not have
+		foreach (PQD_ParsedLoadoutStorage currentStorage : currentStorages)
+		{
+			PQD_ParsedLoadoutStorage savedStorage = FindParsedStorage(currentStorage.id, savedStorages);
+
+			foreach (PQD_ParsedLoadoutItem currentItem : currentStorage.items)
+			{
+				if (savedStorage && savedStorage.FindItem(currentItem.slotIdx))
+					continue;
+
+				PQD_StorageRequest removal = CreateOperation(currentStorage.id, currentItem.slotIdx, storages, arsenalEntityRplId);
+				if (!removal)
+					return false;
+
+				removal.actionType = PQD_ActionType.REMOVE_ITEM;
+				removals.Insert(removal);
+			}
+		}
+
+		// Items that are missing or differ
+		foreach (PQD_ParsedLoadoutStorage savedStorage : savedStorages)
+		{
+			PQD_ParsedLoadoutStorage currentStorage = FindParsedStorage(savedStorage.id, currentStorages);
+
+			foreach (PQD_ParsedLoadoutItem savedItem : savedStorage.items)
+			{
+				PQD_ParsedLoadoutItem currentItem;
+				if (currentStorage)
+					currentItem = currentStorage.FindItem(savedItem.slotIdx);
+
+				if (currentItem && currentItem.prefab == savedItem.prefab)
+				{
+					BaseInventoryStorageComponent storage = ResolveSlot(savedStorage.id, savedItem.slotIdx, storages);
+					if (!storage)
+						return false;
+
+					IEntity item = storage.GetSlot(savedItem.slotIdx).GetAttachedEntity();
+					if (!item)
+						return false;
+
+					// Same item, fix its contents and keep it
+					if (!IsDepleted(item))
+					{
+						if (!DiffStorages(item, savedItem.storages, currentItem.storages, arsenalEntityRplId, removals, replacements))
+							return false;
+
+						continue;
+					}
+				}
+
+				// A new item comes with its default contents, restoring saved ones needs a full apply
+				if (!savedItem.storages.IsEmpty())
+					return false;
+
+				PQD_StorageRequest replacement = CreateOperation(savedStorage.id, savedItem.slotIdx, storages, arsenalEntityRplId);
+				if (!replacement)
+					return false;
+
+				replacement.actionType = PQD_ActionType.REPLACE_ITEM;
+				replacement.prefab = savedItem.prefab;
+				replacements.Insert(replacement);
+			}
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Partly used magazine, the parsed model does not carry item state so the live item is checked
+	//! A replacement comes full, as it would from a full apply
+	protected static bool IsDepleted(IEntity item)
+	{
+		BaseMagazineComponent magazine = BaseMagazineComponent.Cast(item.FindComponent(BaseMagazineComponent));
+		return magazine && magazine.GetAmmoCount() < magazine.GetMaxAmmoCount();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static bool HasDuplicateStorageIds(array<ref PQD_ParsedLoadoutStorage> parsedStorages)
+	{
+		array<string> ids = {};
+		foreach (PQD_ParsedLoadoutStorage parsedStorage : parsedStorages)
+		{
+			if (ids.Contains(parsedStorage.id))
+				return true;
+
+			ids.Insert(parsedStorage.id);
+		}
+
+		return false;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static PQD_ParsedLoadoutStorage FindParsedStorage(string storageId, array<ref PQD_ParsedLoadoutStorage> parsedStorages)
+	{
+		foreach (PQD_ParsedLoadoutStorage parsedStorage : parsedStorages)
+		{
+			if (parsedStorage.id == storageId)
+				return parsedStorage;
+		}
+
+		return null;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static void FindEntityStorages(IEntity entity, notnull array<BaseInventoryStorageComponent> storages)
+	{
+		array<Managed> components = {};
+		entity.FindComponents(BaseInventoryStorageComponent, components);
+
+		foreach (Managed component : components)
+		{
+			BaseInventoryStorageComponent storage = BaseInventoryStorageComponent.Cast(component);
+			if (storage)
+				storages.Insert(storage);
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Storage whose type is exactly the serialized storage id, null if none or several match
+	protected static BaseInventoryStorageComponent FindStorage(string storageId, array<BaseInventoryStorageComponent> storages)
+	{
+		BaseInventoryStorageComponent storage;
+		foreach (BaseInventoryStorageComponent candidate : storages)
+		{
+			if (storageId != candidate.Type().ToString())
+				continue;
+
+			if (storage)
+				return null;
+
+			storage = candidate;
+		}
+
+		return storage;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Storage of a serialized storage id that has the slot, null if the storage cannot be matched unambiguously
+	protected static BaseInventoryStorageComponent ResolveSlot(string storageId, int slotIdx, array<BaseInventoryStorageComponent> storages)
+	{
+		BaseInventoryStorageComponent storage = FindStorage(storageId, storages);
+		if (!storage || !storage.GetSlot(slotIdx))
+			return null;
+
+		return storage;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Storage operation for a serialized storage id and slot index, null if the storage cannot be matched unambiguously
+	protected static PQD_StorageRequest CreateOperation(string storageId, int slotIdx, array<BaseInventoryStorageComponent> storages, RplId arsenalEntityRplId)
+	{
+		BaseInventoryStorageComponent storage = ResolveSlot(storageId, slotIdx, storages);
+		if (!storage)
+			return null;
+
+		RplId storageRplId = Replication.FindId(storage);
+		if (!storageRplId.IsValid())
+			return null;
+
+		PQD_StorageRequest operation = new PQD_StorageRequest();
+		operation.arsenalEntityRplId = arsenalEntityRplId;
+		operation.storageRplId = storageRplId;
+		operation.storageSlotId = slotIdx;
+		return operation;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//! Saved loadout applied to the existing character through a storage batch
+//! Keeps what is needed to fall back to a full replacement if an operation fails
+sealed class PQD_InPlaceLoadoutApply
+{
+	ref PQD_LoadoutRequest request;
+	SCR_ArsenalComponent arsenal;
+	IEntity character;
+	ResourceName prefab;
+	string loadoutData;
+	int playerId;
+	float cost;
+}
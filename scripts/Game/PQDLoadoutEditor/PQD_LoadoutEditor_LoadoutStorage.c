@@ -56,6 +56,52 @@ sealed class PQD_PlayerFactionLoadoutStorage
 		return true;
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Apply serialized loadout data to a character through the vanilla ApplyLoadoutString
+	static bool ApplyToCharacter(notnull GameEntity characterEntity, string loadoutData)
+	{
+		// Without this, inventory items inside backpacks/vests won't be applied!
+		if (!SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK || SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK.IsEmpty())
+		{
+			Print("[PQD] Initializing ARSENALLOADOUT_COMPONENTS_TO_CHECK", LogLevel.WARNING);
+			SCR_ArsenalManagerComponent.GetArsenalLoadoutComponentsToCheck(SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK);
+		}
+		
+		SCR_JsonLoadContext loadContext = new SCR_JsonLoadContext();
+		if (!loadContext.ImportFromString(loadoutData))
+		{
+			Print("[PQD] Failed to parse loadout data", LogLevel.ERROR);
+			return false;
+		}
+		
+		return SCR_PlayerArsenalLoadout.ApplyLoadoutString(characterEntity, loadContext);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Bring the stored respawn cost up to date with the current prices
+	//! Only loadouts priced under another price table version reach PQD_LoadoutCostCache, reads of
+	//! up to date loadouts do not touch the cache and cannot push other kits out of it
+	static void RefreshSupplyCost(string factionKey, PQD_PlayerLoadout playerLoadout)
+	{
+		if (factionKey == "admin" || !playerLoadout.HasData())
+			return;
+		
+		int priceTableVersion = PQD_LoadoutCostCache.GetPriceTableVersion();
+		if (playerLoadout.supplyCostVersion == priceTableVersion)
+			return;
+		
+		SCR_Faction faction = PQD_Helpers.GetFactionFromFactionKey(factionKey);
+		if (!faction)
+			return;
+		
+		float cost;
+		if (!PQD_LoadoutCostCache.GetCost(playerLoadout.data, faction, SCR_EArsenalSupplyCostType.RESPAWN_COST, cost))
+			return;
+		
+		playerLoadout.supplyCost = cost;
+		playerLoadout.supplyCostVersion = priceTableVersion;
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	static void FillPlayerLoadoutWeaponMetadata(BaseInventoryStorageComponent storage, out string outWeapons)
 	{
@@ -129,7 +175,9 @@ sealed class PQD_PlayerFactionLoadoutStorage
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	static bool FillPlayerLoadoutMetadata(IEntity ent, out string outClothes, out string outWeapons, out string outRank)
+	//! Fill the loadout summaries from the serialized kit instead of walking the inventory again
+	//! Only the character's own weapon and clothing slots are visited, for the item display names
+	static bool FillPlayerLoadoutMetadata(IEntity ent, string serialized, out string outClothes, out string outWeapons, out string outRank)
 	{
 		array<BaseInventoryStorageComponent> storages = {};
 		
@@ -140,13 +188,10 @@ sealed class PQD_PlayerFactionLoadoutStorage
 		outWeapons = "";
 		outClothes = "";
 
-		array<IEntity> itemsInLoadout = {};
-
 		PQD_StorageType storageType;
 		foreach (BaseInventoryStorageComponent storage : storages)
 		{
 			storageType = PQD_Helpers.GetStorageType(storage);
-			storage.GetAll(itemsInLoadout);
 			
 			switch (storageType)
 			{
@@ -165,17 +210,17 @@ sealed class PQD_PlayerFactionLoadoutStorage
 		if (outClothes.IsEmpty())
 			outClothes = "N/A";
 		
+		// Every item of the kit at any depth, from the parsed model shared with apply and previews
 		SCR_ECharacterRank loadoutRequiredRank = SCR_ECharacterRank.RENEGADE;
-		if (itemsInLoadout.Count() > 0)
+		PQD_ParsedLoadout parsed = PQD_ParsedLoadout.Get(serialized);
+		if (parsed)
 		{
-			ResourceName prefab;
+			array<ResourceName> prefabs = {};
+			parsed.CollectPrefabs(prefabs);
+			
 			SCR_ECharacterRank rank;
-
-			foreach (IEntity item : itemsInLoadout)
+			foreach (ResourceName prefab : prefabs)
 			{
-				if (!PQD_Helpers.GetResourceNameFromEntity(item, prefab))
-					continue;
-				
 				rank = PQD_Helpers.GetItemRequiredRankFromCache(prefab);
 				
 				if (rank == SCR_ECharacterRank.INVALID)
@@ -217,12 +262,7 @@ sealed class PQD_PlayerFactionLoadoutStorage
 		else
 			newPlayerLoadout.createdAt = currentTime;
 		
-		if (!PQD_PlayerFactionLoadoutStorage.FillPlayerLoadoutMetadata(characterEntity, newPlayerLoadout.metadata_clothes, newPlayerLoadout.metadata_weapons, newPlayerLoadout.required_rank))
-		{
-			Print("[PQD] Failed to fill loadout metadata", LogLevel.ERROR);
-			return false;
-		}
-		
+		// The serializer is the only walk over the whole inventory, metadata, rank and cost are read from its output
 		if (!PQD_PlayerFactionLoadoutStorage.SerializeCharacter(characterEntity, newPlayerLoadout.data))
 		{
 			Print("[PQD] Failed to serialize character", LogLevel.ERROR);
@@ -236,7 +276,13 @@ sealed class PQD_PlayerFactionLoadoutStorage
 			return false;
 		}
 		
-		// Calculate supply cost
+		if (!PQD_PlayerFactionLoadoutStorage.FillPlayerLoadoutMetadata(characterEntity, newPlayerLoadout.data, newPlayerLoadout.metadata_clothes, newPlayerLoadout.metadata_weapons, newPlayerLoadout.required_rank))
+		{
+			Print("[PQD] Failed to fill loadout metadata", LogLevel.ERROR);
+			return false;
+		}
+		
+		// Calculate supply cost, cached per kit so later reads of this loadout do not compute it again
 		if (factionKey != "admin")
 		{
 			SCR_Faction faction = PQD_Helpers.GetFactionFromFactionKey(factionKey);
@@ -247,7 +293,11 @@ sealed class PQD_PlayerFactionLoadoutStorage
 			}
 			
 			float cost;
-			if (!arsenalManager.PQD_GetLoadoutRespawnCost(newPlayerLoadout.data, faction, cost))
+			if (arsenalManager.PQD_GetLoadoutRespawnCost(newPlayerLoadout.data, faction, cost))
+			{
+				newPlayerLoadout.supplyCostVersion = PQD_LoadoutCostCache.GetPriceTableVersion();
+			}
+			else
 			{
 				Print("[PQD] Could not compute loadout cost", LogLevel.WARNING);
 				// Continue anyway - cost calculation is not critical
@@ -341,6 +391,7 @@ sealed class PQD_PlayerFactionLoadoutStorage
 		for (int x = 0; x < max; x++)
 		{
 			PQD_PlayerLoadout loadout = playerFactionLoadouts.Get(x);
+			RefreshSupplyCost(factionKey, loadout);
 
 			// Clone the loadout to avoid reference issues
 			PQD_PlayerLoadout option = new PQD_PlayerLoadout();
@@ -361,6 +412,32 @@ sealed class PQD_PlayerFactionLoadoutStorage
 		}
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Compress every loadout blob in place, used around writing the save file
+	void CompressLoadoutData()
+	{
+		foreach (string factionKey, map<int, ref PQD_PlayerLoadout> factionLoadouts : playerLoadouts)
+		{
+			foreach (int slotId, PQD_PlayerLoadout loadout : factionLoadouts)
+			{
+				loadout.data = PQD_LoadoutCompression.Compress(loadout.data);
+			}
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Restore every loadout blob, files written without compression are left as they are
+	void DecompressLoadoutData()
+	{
+		foreach (string factionKey, map<int, ref PQD_PlayerLoadout> factionLoadouts : playerLoadouts)
+		{
+			foreach (int slotId, PQD_PlayerLoadout loadout : factionLoadouts)
+			{
+				loadout.data = PQD_LoadoutCompression.Decompress(loadout.data);
+			}
+		}
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	//! Validate that the storage data is not corrupted
 	bool ValidateStorageIntegrity()
@@ -380,6 +457,13 @@ sealed class PQD_PlayerFactionLoadoutStorage
 	}
 }
 
+//------------------------------------------------------------------------------------------------
+//! Persistent identity of this server, lets clients key their local loadout cache
+sealed class PQD_ServerIdentity
+{
+	string serverId;
+}
+
 //------------------------------------------------------------------------------------------------
 sealed class PQD_LoadoutStorageComponentClass : SCR_BaseGameModeComponentClass {}
 
@@ -394,6 +478,9 @@ sealed class PQD_LoadoutStorageComponent : SCR_BaseGameModeComponent
 	
 	// Backup path for old version migration
 	protected string loadoutPathLegacy = "$profile:/PQDLoadoutEditor_Loadouts/1.0.0";
+	
+	// Generated once and stored next to the loadouts
+	protected string m_sServerId;
 
 	//------------------------------------------------------------------------------------------------
 	override void OnPlayerDisconnected(int playerId, KickCauseCode cause, int timeout)
@@ -405,6 +492,40 @@ sealed class PQD_LoadoutStorageComponent : SCR_BaseGameModeComponent
 		}
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Identity of this server, stable across restarts as long as the loadout folder is kept
+	string GetServerId()
+	{
+		if (!m_sServerId.IsEmpty())
+			return m_sServerId;
+		
+		string path = string.Format("%1/server_identity", loadoutPathRoot);
+		PQD_ServerIdentity identity = new PQD_ServerIdentity();
+		
+		if (PQD_Helpers.IsFileSavingEnabled() && FileIO.FileExists(path))
+		{
+			SCR_JsonLoadContext loadContext = new SCR_JsonLoadContext();
+			if (loadContext.LoadFromFile(path))
+				loadContext.ReadValue("", identity);
+		}
+		
+		if (identity.serverId.IsEmpty())
+		{
+			identity.serverId = string.Format("%1%2", PQD_TimeHelper.GetCurrentTimestamp(), Math.RandomInt(100000, 999999));
+			
+			if (PQD_Helpers.IsFileSavingEnabled())
+			{
+				EnsureDirectoryExists(loadoutPathRoot);
+				SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
+				saveContext.WriteValue("", identity);
+				saveContext.SaveToFile(path);
+			}
+		}
+		
+		m_sServerId = identity.serverId;
+		return m_sServerId;
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	//! Ensure the storage directories exist
 	protected void EnsureDirectoryExists(string path)
@@ -531,7 +652,20 @@ sealed class PQD_LoadoutStorageComponent : SCR_BaseGameModeComponent
 		// Serialize to JSON
 		SCR_JsonSaveContext ctx = new SCR_JsonSaveContext();
 		
-		if (!ctx.WriteValue("", loadoutStorage.Get(playerId)))
+		// In-memory blobs stay uncompressed, only the written copy is compressed
+		PQD_PlayerFactionLoadoutStorage playerLoadoutStorage = loadoutStorage.Get(playerId);
+		PQD_GameModeComponent gameModeComponent = PQD_GameModeComponent.GetInstance();
+		bool compress = gameModeComponent && gameModeComponent.IsStoredLoadoutCompressionEnabled();
+		
+		if (compress)
+			playerLoadoutStorage.CompressLoadoutData();
+		
+		bool serialized = ctx.WriteValue("", playerLoadoutStorage);
+		
+		if (compress)
+			playerLoadoutStorage.DecompressLoadoutData();
+		
+		if (!serialized)
 		{
 			Print("[PQD] SavePlayerLoadoutToFile: Failed to serialize loadout data", LogLevel.ERROR);
 			return false;
@@ -621,6 +755,7 @@ sealed class PQD_LoadoutStorageComponent : SCR_BaseGameModeComponent
 		
 		// Validate loaded data
 		playerLoadoutStorage.ValidateStorageIntegrity();
+		playerLoadoutStorage.DecompressLoadoutData();
 		
 		Print(string.Format("[PQD] LoadPlayerLoadoutFromFile: SUCCESS - Loaded loadout from file for faction %1, identity %2", factionKey, identityId), LogLevel.NORMAL);
 		
@@ -696,6 +831,8 @@ sealed class PQD_LoadoutStorageComponent : SCR_BaseGameModeComponent
 			return false;
 		}
 
+		PQD_PlayerFactionLoadoutStorage.RefreshSupplyCost(factionKey, playerLoadout);
+		
 		loadoutData = playerLoadout.data;
 		prefab = playerLoadout.prefab;
 		cost = playerLoadout.supplyCost;
@@ -48,6 +48,7 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 	
 	// Cache
 	ref PQD_Cache m_Cache = new PQD_Cache();
+	ref PQD_StorageTreeSnapshot m_StorageTree = new PQD_StorageTreeSnapshot();
 	
 	// Player controller component
 	PQD_PlayerControllerComponent m_pcComponent;
@@ -65,6 +66,14 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 	
 	static bool m_bIntroDialogConfirmed = false;
 	
+	// Draft mode - slot choices are collected locally and committed as one storage batch
+	static bool m_bDraftModeEnabled = false;
+	static const string DRAFT_OPTION_LABEL = "Draft mode";
+	ref PQD_LoadoutDraft m_Draft;
+	
+	// Optimistic updates - sequence id -> predicted slot content until the server answers
+	ref map<int, ref PQD_SlotPrediction> m_mPredictions = new map<int, ref PQD_SlotPrediction>();
+	
 	// Editor options
 	static ref map<string, PQD_EditorOptionComponent> m_EditorOptions = new map<string, PQD_EditorOptionComponent>;
 
@@ -345,9 +354,13 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 		if (IsUIWaiting())
 			return;
 		
-		// Only works in loadout modes
+		// Outside loadout modes the save key commits pending draft changes
 		if (m_eCurrentMode != PQD_EditorMode.LOADOUTS && m_eCurrentMode != PQD_EditorMode.SERVER_LOADOUTS)
+		{
+			if (IsDraftMode() && m_Draft.HasChanges())
+				CommitDraft();
 			return;
+		}
 		
 		if (!m_wSlotChoicesListbox)
 			return;
@@ -501,10 +514,17 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 		
 		m_pcComponent.m_OnResponse_Storage.Insert(OnServerResponse_Storage);
 		m_pcComponent.m_OnResponse_Loadout.Insert(OnServerResponse_Loadout);
+		m_pcComponent.m_OnResponse_StorageBatch.Insert(OnServerResponse_StorageBatch);
 		
 		if (!m_Cache.Init(m_arsenalComponent))
 			ShowWarning("This arsenal seems to have no items!");
 		
+		m_Cache.SetEditedCharacter(m_CharacterEntity);
+		m_StorageTree.Bind(m_CharacterEntity);
+		
+		if (m_bDraftModeEnabled)
+			m_Draft = new PQD_LoadoutDraft();
+		
 		// Start in Character mode
 		SetUIWaiting(true);
 		SetLoadoutEditorMode(PQD_EditorMode.CHARACTER);
@@ -557,6 +577,17 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 		Print(string.Format("[PQD] New player character entity: %1", to), LogLevel.DEBUG);
 
 		m_CharacterEntity = to;
+		m_Cache.SetEditedCharacter(to);
+		m_StorageTree.Bind(to);
+		
+		// Drafted changes point at storages of the previous character
+		if (m_Draft && m_Draft.HasChanges())
+		{
+			m_Draft.Clear();
+			if (m_wStatusMessageWidget)
+				m_wStatusMessageWidget.ShowMessage("Character changed, draft discarded", PQD_MessageType.WARNING);
+		}
+		
 		GetGame().GetCallqueue().CallLater(DelayedUpdatePlayerCharacter, 500, false);
 	}
 	
@@ -991,6 +1022,16 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 			return;
 		}
 		
+		if (m_eCurrentMode == PQD_EditorMode.OPTIONS)
+		{
+			PQD_EditorOptionData optionData = PQD_EditorOptionData.Cast(data);
+			if (optionData && optionData.editorOptionLabel == DRAFT_OPTION_LABEL)
+			{
+				HandleDraftOption(optionData.optionValue);
+				return;
+			}
+		}
+		
 		if (m_eCurrentMode == PQD_EditorMode.OPTIONS && m_slotHistory.Count() > 0)
 		{
 			HandleChangedEditorOption(PQD_EditorOptionData.Cast(data));
@@ -1210,7 +1251,15 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 	//------------------------------------------------------------------------------------------------
 	protected void Destroy()
 	{
+		// No commit from a closing menu, its response would have nowhere to go
+		if (m_Draft && m_Draft.HasChanges())
+		{
+			Print(string.Format("[PQD] Menu closed, discarding %1 drafted changes", m_Draft.Count()), LogLevel.DEBUG);
+			m_Draft.Clear();
+		}
+		
 		SCR_PlayerController.Cast(GetGame().GetPlayerController()).m_OnControlledEntityChanged.Remove(OnControlledEntityChanged);
+		m_StorageTree.Unbind();
 		
 		MenuManager menuManager = GetGame().GetMenuManager();
 		menuManager.CloseMenuByPreset(ChimeraMenuPreset.PQD_LoadoutEditor);
@@ -1869,6 +1918,16 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 			return;
 		}
 		
+		if (IsDraftMode())
+		{
+			DraftSlotChoice(editedSlot, slotChoice);
+			return;
+		}
+		
+		// Unrelated slots stay editable while earlier requests are processed
+		if (!CanRequestSlotChange())
+			return;
+		
 		// Handle remove item option
 		if (slotChoice.prefab.IsEmpty())
 		{
@@ -1879,8 +1938,7 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 			request.storageRplId = m_Cache.GetStorageRplId(editedSlot.slot.GetStorage());
 			request.storageSlotId = editedSlot.storageSlotId;
 			
-			SetUIWaiting(true);
-			m_pcComponent.RequestAction(request);
+			SendOptimisticRequest(request);
 			return;
 		}
 		
@@ -1902,14 +1960,141 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 		if (m_wSlotChoicesListbox)
 			m_iListBoxLastActionChild = m_wSlotChoicesListbox.GetFocusedItem();
 		
-		SetUIWaiting(true);
-		m_pcComponent.RequestAction(request);
+		SendOptimisticRequest(request);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Send a slot request and show its expected result right away instead of blocking the UI
+	void SendOptimisticRequest(PQD_StorageRequest request)
+	{
+		PQD_SlotPrediction prediction = new PQD_SlotPrediction();
+		prediction.storageRplId = request.storageRplId;
+		prediction.storageSlotId = request.storageSlotId;
+		prediction.prefab = request.prefab;
+		prediction.sentAt = System.GetTickCount();
+		prediction.sequenceId = m_pcComponent.RequestAction(request);
+		m_mPredictions.Set(prediction.sequenceId, prediction);
+		
+		RefreshSlotRow(prediction.storageRplId, prediction.storageSlotId);
+		if (m_wPreviewWidgetComponent && !prediction.prefab.IsEmpty())
+			m_wPreviewWidgetComponent.SetPreviewedPrefab(prediction.prefab);
+		
+		PQD_Helpers.PlaySoundForSlotType(PQD_SlotType.OPTION);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Re-render the listed rows of one slot with its current or predicted content
+	void RefreshSlotRow(RplId storageRplId, int storageSlotId)
+	{
+		if (!m_wSlotChoicesListbox)
+			return;
+		
+		// Only these modes list storage slot rows
+		if (m_eCurrentMode != PQD_EditorMode.CHARACTER && m_eCurrentMode != PQD_EditorMode.ENTITY)
+			return;
+		
+		int itemCount = m_wSlotChoicesListbox.GetItemCount();
+		for (int i = 0; i < itemCount; i++)
+		{
+			PQD_SlotInfo slotInfo = PQD_SlotInfo.Cast(m_wSlotChoicesListbox.GetItemData(i));
+			if (!slotInfo || !slotInfo.slot || slotInfo.storageSlotId != storageSlotId)
+				continue;
+			
+			BaseInventoryStorageComponent storage = slotInfo.slot.GetStorage();
+			if (!storage || m_Cache.GetStorageRplId(storage) != storageRplId)
+				continue;
+			
+			m_wSlotChoicesListbox.UpdateItem_Slot(i, BuildStorageSlotInfo(slotInfo.storageType, storage, storageSlotId));
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Check the in-flight window and make sure no pending request touches the edited slot or its parents
+	bool CanRequestSlotChange()
+	{
+		ExpirePredictions();
+		
+		string message;
+		
+		if (!m_pcComponent.CanSendRequest())
+		{
+			message = "Too many pending changes, waiting for server...";
+		}
+		else
+		{
+			foreach (PQD_SlotInfo slotInfo : m_slotHistory)
+			{
+				if (!slotInfo.slot)
+					continue;
+				
+				ResourceName predictedPrefab;
+				if (GetPredictedSlot(m_Cache.GetStorageRplId(slotInfo.slot.GetStorage()), slotInfo.storageSlotId, predictedPrefab))
+				{
+					message = "Waiting for server on this slot...";
+					break;
+				}
+			}
+		}
+		
+		if (message.IsEmpty())
+			return true;
+		
+		if (m_wStatusMessageWidget)
+			m_wStatusMessageWidget.ShowMessage(message, PQD_MessageType.WARNING);
+		PQD_Helpers.PlaySound("blocked");
+		return false;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Returns the predicted content of a slot if a request for it is in flight
+	bool GetPredictedSlot(RplId storageRplId, int storageSlotId, out ResourceName prefab)
+	{
+		foreach (int sequenceId, PQD_SlotPrediction prediction : m_mPredictions)
+		{
+			if (prediction.expired)
+				continue;
+			
+			if (prediction.storageRplId == storageRplId && prediction.storageSlotId == storageSlotId)
+			{
+				prefab = prediction.prefab;
+				return true;
+			}
+		}
+		
+		return false;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Stop showing predictions whose response never came, their slots show the replicated state again
+	//! Expired predictions are kept a while longer so a late response is still matched to its slot
+	void ExpirePredictions()
+	{
+		int now = System.GetTickCount();
+		array<int> dropped = {};
+		foreach (int sequenceId, PQD_SlotPrediction prediction : m_mPredictions)
+		{
+			int age = now - prediction.sentAt;
+			if (!prediction.expired && age > PQD_PlayerControllerComponent.IN_FLIGHT_TIMEOUT_MS)
+			{
+				prediction.expired = true;
+				RefreshSlotRow(prediction.storageRplId, prediction.storageSlotId);
+			}
+			
+			if (age > PQD_PlayerControllerComponent.IN_FLIGHT_TIMEOUT_MS * 4)
+				dropped.Insert(sequenceId);
+		}
+		
+		foreach (int sequenceId : dropped)
+		{
+			m_mPredictions.Remove(sequenceId);
+		}
 	}
 	
 	//------------------------------------------------------------------------------------------------
 	//! Validate that the player meets rank and supply requirements for an item
 	//! Returns true if the item can be equipped, false otherwise (and shows error message)
-	bool ValidateItemRequirements(ResourceName prefab)
+	//! pendingCost is supply already reserved by drafted changes
+	bool ValidateItemRequirements(ResourceName prefab, float pendingCost = 0)
 	{
 		if (!m_Cache || prefab.IsEmpty())
 			return true;
@@ -1944,10 +2129,10 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 			if (m_RankAndSupplyComponent)
 				availableSupply = m_RankAndSupplyComponent.GetAvailableSupply();
 			
-			if (availableSupply < cost)
+			if (availableSupply < cost + pendingCost)
 			{
 				if (m_wStatusMessageWidget)
-					m_wStatusMessageWidget.ShowMessage(string.Format("Not enough supplies! Need: %1, Have: %2", Math.Round(cost), Math.Round(availableSupply)), PQD_MessageType.ERROR);
+					m_wStatusMessageWidget.ShowMessage(string.Format("Not enough supplies! Need: %1, Have: %2", Math.Round(cost + pendingCost), Math.Round(availableSupply)), PQD_MessageType.ERROR);
 				
 				PQD_Helpers.PlaySound("blocked");
 				return false;
@@ -2067,9 +2252,18 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 	//------------------------------------------------------------------------------------------------
 	void CreateSlotsForMultipleStorages()
 	{
-		array<BaseInventoryStorageComponent> storages = {};
-		int numStorages = PQD_Helpers.GetAllEntityStorages(m_EditedEntity, storages);
+		array<BaseInventoryStorageComponent> storages;
+		if (m_StorageTree.IsBoundTo(m_EditedEntity))
+		{
+			storages = m_StorageTree.GetCharacterStorages();
+		}
+		else
+		{
+			storages = {};
+			PQD_Helpers.GetAllEntityStorages(m_EditedEntity, storages);
+		}
 		
+		int numStorages = storages.Count();
 		if (numStorages < 1)
 		{
 			ShowWarning("No storage component found in entity");
@@ -2095,8 +2289,18 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 	//------------------------------------------------------------------------------------------------
 	void CreateSlotsForCharacterStorages()
 	{
-		array<InventoryStorageSlot> storageSlots = {};
-		int numStorageSlots = PQD_Helpers.GetAllCharacterItemStorageSlots(m_CharacterEntity, storageSlots);
+		array<InventoryStorageSlot> storageSlots;
+		if (m_StorageTree.IsBoundTo(m_CharacterEntity))
+		{
+			storageSlots = m_StorageTree.GetContainerSlots();
+		}
+		else
+		{
+			storageSlots = {};
+			PQD_Helpers.GetAllCharacterItemStorageSlots(m_CharacterEntity, storageSlots);
+		}
+		
+		int numStorageSlots = storageSlots.Count();
 		
 		if (m_wSlotChoicesListbox)
 			m_wSlotChoicesListbox.Clear();
@@ -2177,6 +2381,18 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 	
 	//------------------------------------------------------------------------------------------------
 	PQD_SlotInfo CreateStorageSlotWithInfo(PQD_StorageType storageType, BaseInventoryStorageComponent storage, int storageSlotId)
+	{
+		PQD_SlotInfo slotInfo = BuildStorageSlotInfo(storageType, storage, storageSlotId);
+		
+		if (m_wSlotChoicesListbox)
+			slotInfo.listBoxChildId = m_wSlotChoicesListbox.AddItem_Slot(slotInfo);
+		
+		return slotInfo;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Slot info of a storage slot as it should be shown, including pending and drafted changes
+	PQD_SlotInfo BuildStorageSlotInfo(PQD_StorageType storageType, BaseInventoryStorageComponent storage, int storageSlotId)
 	{
 		InventoryStorageSlot storageSlot = storage.GetSlot(storageSlotId);
 
@@ -2215,9 +2431,12 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 
 		slotInfo.storageType = storageType;
 		slotInfo.slot = storageSlot;
-
-		if (m_wSlotChoicesListbox)
-			slotInfo.listBoxChildId = m_wSlotChoicesListbox.AddItem_Slot(slotInfo);
+		
+		if (!m_mPredictions.IsEmpty())
+			ApplyPredictionToSlotInfo(slotInfo);
+		
+		if (IsDraftMode())
+			ApplyDraftToSlotInfo(slotInfo);
 		
 		return slotInfo;
 	}
@@ -2260,6 +2479,153 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 			// No options registered - show default info
 			CreateDefaultEditorOptions();
 		}
+		
+		CreateDraftEditorOptions();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void CreateDraftEditorOptions()
+	{
+		if (!m_wSlotChoicesListbox)
+			return;
+		
+		PQD_EditorOptionData toggleOption = new PQD_EditorOptionData();
+		toggleOption.editorOptionLabel = DRAFT_OPTION_LABEL;
+		toggleOption.optionValue = "toggle";
+		if (IsDraftMode())
+			toggleOption.optionLabel = "Draft mode: ON (changes are applied on commit)";
+		else
+			toggleOption.optionLabel = "Draft mode: OFF (changes are applied immediately)";
+		m_wSlotChoicesListbox.AddItem_Option(toggleOption);
+		
+		if (!m_Draft || !m_Draft.HasChanges())
+			return;
+		
+		PQD_EditorOptionData commitOption = new PQD_EditorOptionData();
+		commitOption.editorOptionLabel = DRAFT_OPTION_LABEL;
+		commitOption.optionValue = "commit";
+		commitOption.optionLabel = string.Format("Commit draft (%1 changes, cost %2)", m_Draft.Count(), Math.Round(m_Draft.GetTotalCost(m_Cache)));
+		m_wSlotChoicesListbox.AddItem_Option(commitOption);
+		
+		PQD_EditorOptionData discardOption = new PQD_EditorOptionData();
+		discardOption.editorOptionLabel = DRAFT_OPTION_LABEL;
+		discardOption.optionValue = "discard";
+		discardOption.optionLabel = "Discard draft";
+		m_wSlotChoicesListbox.AddItem_Option(discardOption);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsDraftMode()
+	{
+		return m_bDraftModeEnabled && m_Draft;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void HandleDraftOption(string value)
+	{
+		switch (value)
+		{
+			case "toggle":
+				m_bDraftModeEnabled = !m_bDraftModeEnabled;
+				if (m_bDraftModeEnabled && !m_Draft)
+					m_Draft = new PQD_LoadoutDraft();
+				
+				// Leaving draft mode applies what was drafted so far
+				if (!m_bDraftModeEnabled && m_Draft && m_Draft.HasChanges())
+					CommitDraft();
+				break;
+			case "commit":
+				CommitDraft();
+				break;
+			case "discard":
+				if (m_Draft)
+					m_Draft.Clear();
+				HandleMessage(true, "Draft discarded");
+				break;
+		}
+		
+		if (!IsUIWaiting())
+			CreateSlotsForEditorOptions();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Record a slot choice in the draft, validated locally against cached cost and rank
+	void DraftSlotChoice(PQD_SlotInfo editedSlot, PQD_SlotChoice slotChoice)
+	{
+		RplId storageRplId = m_Cache.GetStorageRplId(editedSlot.slot.GetStorage());
+		
+		if (!slotChoice.prefab.IsEmpty())
+		{
+			// Supply reserved by other drafted slots, the choice for this slot gets replaced
+			float pendingCost = m_Draft.GetTotalCost(m_Cache) - m_Draft.GetSlotCost(m_Cache, storageRplId, editedSlot.storageSlotId);
+			if (!ValidateItemRequirements(slotChoice.prefab, pendingCost))
+			{
+				SetUIWaiting(false);
+				return;
+			}
+		}
+		
+		ResourceName originalPrefab;
+		PQD_Helpers.GetResourceNameFromEntity(editedSlot.slot.GetAttachedEntity(), originalPrefab);
+		m_Draft.SetChange(storageRplId, editedSlot.storageSlotId, originalPrefab, slotChoice.prefab);
+		
+		if (m_wStatusMessageWidget)
+			m_wStatusMessageWidget.ShowMessage(string.Format("Draft: %1 pending changes (cost %2)", m_Draft.Count(), Math.Round(m_Draft.GetTotalCost(m_Cache))), PQD_MessageType.OK);
+		PQD_Helpers.PlaySoundForSlotType(PQD_SlotType.OPTION);
+		
+		if (m_wSlotChoicesListbox)
+			m_iListBoxLastActionChild = m_wSlotChoicesListbox.GetFocusedItem();
+		
+		SetUIWaiting(false);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Show the drafted item instead of the one currently on the character
+	void ApplyDraftToSlotInfo(PQD_SlotInfo slotInfo)
+	{
+		if (!slotInfo.slot)
+			return;
+		
+		ResourceName draftPrefab;
+		if (m_Draft.GetChange(m_Cache.GetStorageRplId(slotInfo.slot.GetStorage()), slotInfo.storageSlotId, draftPrefab))
+			OverrideSlotInfoPrefab(slotInfo, draftPrefab, "draft");
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Show the predicted item for slots with a request in flight
+	void ApplyPredictionToSlotInfo(PQD_SlotInfo slotInfo)
+	{
+		if (!slotInfo.slot)
+			return;
+		
+		ResourceName predictedPrefab;
+		if (GetPredictedSlot(m_Cache.GetStorageRplId(slotInfo.slot.GetStorage()), slotInfo.storageSlotId, predictedPrefab))
+			OverrideSlotInfoPrefab(slotInfo, predictedPrefab, "pending");
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void OverrideSlotInfoPrefab(PQD_SlotInfo slotInfo, ResourceName prefab, string tag)
+	{
+		// Contents of an item that isn't on the character yet can't be edited
+		slotInfo.hasStorage = false;
+		slotInfo.prefab = prefab;
+		
+		if (prefab.IsEmpty())
+			slotInfo.itemName = "";
+		else
+			slotInfo.itemName = string.Format("%1 (%2)", PQD_Helpers.GetItemNameFromPrefab(prefab), tag);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void CommitDraft()
+	{
+		if (!m_Draft || !m_Draft.HasChanges() || !m_pcComponent)
+			return;
+		
+		PQD_StorageBatchRequest request = m_Draft.BuildCommitRequest(PQD_Helpers.GetEntityRplId(m_ArsenalEntity));
+		
+		SetUIWaiting(true);
+		m_pcComponent.RequestStorageBatch(request);
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -2365,9 +2731,69 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 	void OnServerResponse_Storage(PQD_NetworkResponse response, PQD_StorageRequest request)
 	{
 		HandleMessage(response.success, response.message);
+		
+		if (request && m_mPredictions.Contains(request.sequenceId))
+		{
+			if (!response.success)
+			{
+				// Rollback - drop the prediction and show the slot as it really is
+				m_mPredictions.Remove(request.sequenceId);
+				RefreshPredictedSlot(request.storageRplId, request.storageSlotId);
+				return;
+			}
+			
+			// Keep showing the prediction until replication has caught up with the response
+			GetGame().GetCallqueue().CallLater(ConfirmPrediction, 66, false, request.sequenceId);
+			return;
+		}
+		
 		GetGame().GetCallqueue().CallLater(RefreshUpdatedSlot, 66, false, response.success, request.storageRplId, request.storageSlotId);
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Replace a confirmed prediction with the replicated state, which also corrects any server-side difference
+	void ConfirmPrediction(int sequenceId)
+	{
+		PQD_SlotPrediction prediction = m_mPredictions.Get(sequenceId);
+		if (!prediction)
+			return;
+		
+		m_mPredictions.Remove(sequenceId);
+		RefreshPredictedSlot(prediction.storageRplId, prediction.storageSlotId);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Show the real content of a slot once its prediction is settled
+	//! Only the slot row and the preview change, a loadout request may hold the waiting state meanwhile
+	void RefreshPredictedSlot(RplId storageRplId, int storageSlotId)
+	{
+		RefreshSlotRow(storageRplId, storageSlotId);
+		
+		if (m_wPreviewWidgetComponent && (m_eCurrentMode == PQD_EditorMode.CHARACTER || m_eCurrentMode == PQD_EditorMode.ENTITY))
+			m_wPreviewWidgetComponent.RefreshPreview();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void OnServerResponse_StorageBatch(PQD_NetworkResponse response, PQD_StorageBatchRequest request)
+	{
+		HandleMessage(response.success, response.message);
+		
+		if (m_Draft && request && request.validateAll)
+			m_Draft.ApplyCommitResults(response.operationResults);
+		
+		if (response.operationResults)
+		{
+			foreach (int i, PQD_StorageOperationResult result : response.operationResults)
+			{
+				if (result && !result.success)
+					Print(string.Format("[PQD] Batch operation %1 failed: %2", i, result.message), LogLevel.DEBUG);
+			}
+		}
+		
+		// Partial success still changed the character - always refresh
+		GetGame().GetCallqueue().CallLater(RefreshUpdatedSlot, 66, false, true, RplId.Invalid(), -1);
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	void OnServerResponse_Loadout(PQD_NetworkResponse response, PQD_LoadoutRequest request)
 	{
@@ -2383,6 +2809,13 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 			CreateSlotsForLoadoutOptions(response.message);
 		}
 		
+		// Applied in place - the character is kept, so OnControlledEntityChanged will not refresh the preview
+		if (response.success && (request.actionType == PQD_ActionType.APPLY_LOADOUT || request.actionType == PQD_ActionType.APPLY_LOADOUT_ADMIN))
+		{
+			if (SCR_PlayerController.GetLocalControlledEntity() == m_CharacterEntity)
+				GetGame().GetCallqueue().CallLater(DelayedUpdatePlayerCharacter, 500, false);
+		}
+		
 		SetUIWaiting(false);
 	}
 	
@@ -2412,6 +2845,9 @@ sealed class PQD_LoadoutEditor : ChimeraMenuBase
 			return;
 		}
 		
+		// Swapped items leave their storages behind
+		m_Cache.PruneStorages();
+		
 		// In STORAGE mode (Items tab), just refresh the inventory list
 		if (m_eCurrentMode == PQD_EditorMode.STORAGE)
 		{
@@ -7,6 +7,7 @@
 class PQD_NetworkRequest
 {
 	PQD_ActionType actionType;
+	int sequenceId; // Client-generated, echoed back in the response
 	
 	string Repr()
 	{
@@ -22,20 +23,95 @@ sealed class PQD_StorageRequest : PQD_NetworkRequest
 	RplId storageRplId;
 	int storageSlotId = -1;
 	ResourceName prefab = "";
+	int prefabId = -1; // PQD_PrefabDictionary ID, replaces prefab on the wire when known
+
+	override string Repr()
+	{
+		return string.Format("action: %1, rplId: %2, slotId: %3, prefab: %4, prefabId: %5",
+			SCR_Enum.GetEnumName(PQD_ActionType, actionType), storageRplId, storageSlotId, prefab, prefabId);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Swap the prefab string for its dictionary ID before sending
+	void CompactPrefab()
+	{
+		int id = PQD_PrefabDictionary.GetPrefabId(prefab);
+		if (id == -1)
+			return;
+
+		prefabId = id;
+		prefab = "";
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Restore the prefab string from its dictionary ID after receiving
+	void ExpandPrefab()
+	{
+		if (prefabId == -1)
+			return;
+
+		prefab = PQD_PrefabDictionary.GetPrefab(prefabId);
+		prefabId = -1;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+// Ordered list of storage operations executed by the server in one round-trip
+sealed class PQD_StorageBatchRequest : PQD_NetworkRequest
+{
+	RplId arsenalEntityRplId;
+	ref array<ref PQD_StorageRequest> operations = {};
+	bool validateAll; // Reject the whole batch if any operation fails validation, operations that fail while executing are not rolled back
+	
+	void PQD_StorageBatchRequest()
+	{
+		actionType = PQD_ActionType.STORAGE_BATCH;
+	}
 	
 	override string Repr()
 	{
-		return string.Format("action: %1, rplId: %2, slotId: %3, prefab: %4", 
-			SCR_Enum.GetEnumName(PQD_ActionType, actionType), storageRplId, storageSlotId, prefab);
+		return string.Format("action: %1, operations: %2", 
+			SCR_Enum.GetEnumName(PQD_ActionType, actionType), operations.Count());
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void CompactPrefabs()
+	{
+		foreach (PQD_StorageRequest operation : operations)
+		{
+			operation.CompactPrefab();
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void ExpandPrefabs()
+	{
+		foreach (PQD_StorageRequest operation : operations)
+		{
+			operation.ExpandPrefab();
+		}
 	}
 }
 
+//------------------------------------------------------------------------------------------------
+// Result of a single operation inside a PQD_StorageBatchRequest
+sealed class PQD_StorageOperationResult
+{
+	bool success;
+	string message;
+}
+
 //------------------------------------------------------------------------------------------------
 // Loadout operation request
 sealed class PQD_LoadoutRequest : PQD_NetworkRequest
 {
 	int loadoutSlotId = -1;
 	RplId arsenalComponentRplId;
+	
+	// SET_AI_LOADOUT_ADMIN only
+	PQD_BulkApplyScope bulkScope;
+	string bulkFactionKey; // FACTION scope, empty for the admin's own faction
+	ref array<RplId> bulkTargets = {}; // ENTITIES scope
 }
 
 //------------------------------------------------------------------------------------------------
@@ -45,4 +121,5 @@ sealed class PQD_NetworkResponse
 	bool success;
 	string message;
 	ref PQD_NetworkRequest request;
+	ref array<ref PQD_StorageOperationResult> operationResults; // Only set for STORAGE_BATCH
 }
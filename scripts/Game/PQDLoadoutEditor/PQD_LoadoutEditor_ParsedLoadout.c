@@ -0,0 +1,235 @@
+// PQD Loadout Editor - Parsed Loadout Model
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Structured view of a serialized loadout, parsed once per content and shared by every reader
+
+//------------------------------------------------------------------------------------------------
+//! Item in a storage slot, with the storages of the item itself (container contents, attachments)
+sealed class PQD_ParsedLoadoutItem
+{
+	int slotIdx;
+	ResourceName prefab;
+	ref array<ref PQD_ParsedLoadoutStorage> storages = {};
+}
+
+//------------------------------------------------------------------------------------------------
+//! One serialized storage component and the items in its slots
+sealed class PQD_ParsedLoadoutStorage
+{
+	string id; // Storage component type
+	ref array<ref PQD_ParsedLoadoutItem> items = {};
+	
+	//------------------------------------------------------------------------------------------------
+	//! Item in a slot, null if the slot is empty
+	PQD_ParsedLoadoutItem FindItem(int slotIdx)
+	{
+		foreach (PQD_ParsedLoadoutItem item : items)
+		{
+			if (item.slotIdx == slotIdx)
+				return item;
+		}
+		
+		return null;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//! Parsed serialized loadout, get instances through PQD_ParsedLoadout.Get
+sealed class PQD_ParsedLoadout
+{
+	// Parsed loadouts kept around, least recently used is dropped first
+	static const int MAX_CACHED_LOADOUTS = 32;
+	
+	protected static ref map<int, ref PQD_ParsedLoadout> s_mCache = new map<int, ref PQD_ParsedLoadout>();
+	protected static ref array<int> s_aCacheOrder = {};
+	
+	protected string m_sSource;
+	
+	// Faction the kit was saved for, empty if not recorded
+	string factionKey;
+	
+	// Character storages
+	ref array<ref PQD_ParsedLoadoutStorage> storages = {};
+	
+	//------------------------------------------------------------------------------------------------
+	//! Parsed model of a serialized loadout, null if it cannot be parsed
+	static PQD_ParsedLoadout Get(string loadoutData)
+	{
+		if (loadoutData.IsEmpty())
+			return null;
+		
+		int hash = loadoutData.Hash();
+		
+		PQD_ParsedLoadout parsed = s_mCache.Get(hash);
+		if (parsed && parsed.m_sSource == loadoutData)
+		{
+			s_aCacheOrder.RemoveItemOrdered(hash);
+			s_aCacheOrder.Insert(hash);
+			return parsed;
+		}
+		
+		parsed = Parse(loadoutData);
+		if (!parsed)
+			return null;
+		
+		if (!s_mCache.Contains(hash) && s_mCache.Count() >= MAX_CACHED_LOADOUTS)
+		{
+			s_mCache.Remove(s_aCacheOrder[0]);
+			s_aCacheOrder.RemoveOrdered(0);
+		}
+		
+		s_mCache.Set(hash, parsed);
+		s_aCacheOrder.RemoveItemOrdered(hash);
+		s_aCacheOrder.Insert(hash);
+		return parsed;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void ClearCache()
+	{
+		s_mCache.Clear();
+		s_aCacheOrder.Clear();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Parse without caching, for one-off data such as the serialized live character
+	static PQD_ParsedLoadout Parse(string loadoutData)
+	{
+		SCR_JsonLoadContext context = new SCR_JsonLoadContext();
+		if (!context.ImportFromString(loadoutData))
+		{
+			Print("[PQD] ParsedLoadout: Failed to parse JSON", LogLevel.WARNING);
+			return null;
+		}
+		
+		PQD_ParsedLoadout parsed = new PQD_ParsedLoadout();
+		parsed.m_sSource = loadoutData;
+		context.ReadValue(SCR_PlayerArsenalLoadout.ARSENALLOADOUT_FACTION_KEY, parsed.factionKey);
+		
+		if (!context.StartObject(SCR_PlayerArsenalLoadout.ARSENALLOADOUT_KEY))
+		{
+			Print("[PQD] ParsedLoadout: No arsenalLoadout object", LogLevel.WARNING);
+			return null;
+		}
+		
+		ReadStorages(context, parsed.storages);
+		
+		context.EndObject();
+		return parsed;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Read the "storages" array of the current object, recursing into item storages
+	protected static void ReadStorages(SCR_JsonLoadContext context, array<ref PQD_ParsedLoadoutStorage> storages)
+	{
+		int storageCount;
+		if (!context.StartArray("storages", storageCount))
+			return;
+		
+		for (int nStorage = 0; nStorage < storageCount; nStorage++)
+		{
+			if (!context.StartObject())
+				continue;
+			
+			PQD_ParsedLoadoutStorage storage = new PQD_ParsedLoadoutStorage();
+			if (!context.ReadValue("id", storage.id))
+			{
+				context.EndObject();
+				continue;
+			}
+			
+			int slotCount;
+			if (context.StartMap("slots", slotCount))
+			{
+				for (int i = 0; i < slotCount; i++)
+				{
+					string slotIdxStr;
+					if (!context.ReadMapKey(i, slotIdxStr))
+						continue;
+					
+					int slotIdx = slotIdxStr.ToInt(-1);
+					if (slotIdx == -1)
+						continue;
+					
+					if (!context.StartObject(slotIdxStr))
+						continue;
+					
+					PQD_ParsedLoadoutItem item = new PQD_ParsedLoadoutItem();
+					item.slotIdx = slotIdx;
+					if (context.ReadValue("prefab", item.prefab) && !item.prefab.IsEmpty())
+					{
+						ReadStorages(context, item.storages);
+						storage.items.Insert(item);
+					}
+					
+					context.EndObject();
+				}
+				
+				context.EndMap();
+			}
+			
+			storages.Insert(storage);
+			context.EndObject();
+		}
+		
+		context.EndArray();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Distinct prefabs of every item, at any depth
+	void CollectPrefabs(notnull array<ResourceName> prefabs)
+	{
+		CollectStoragePrefabs(storages, prefabs);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void CollectStoragePrefabs(array<ref PQD_ParsedLoadoutStorage> storages, array<ResourceName> prefabs)
+	{
+		foreach (PQD_ParsedLoadoutStorage storage : storages)
+		{
+			foreach (PQD_ParsedLoadoutItem item : storage.items)
+			{
+				if (!prefabs.Contains(item.prefab))
+					prefabs.Insert(item.prefab);
+				
+				CollectStoragePrefabs(item.storages, prefabs);
+			}
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Clothing and weapons of the character, as used by the vanilla loadout previews
+	SCR_PlayerLoadoutData ToPlayerLoadoutData()
+	{
+		SCR_PlayerLoadoutData result = new SCR_PlayerLoadoutData();
+		
+		foreach (PQD_ParsedLoadoutStorage storage : storages)
+		{
+			// Weapons are in EquipedWeaponStorageComponent
+			// Clothes are in SCR_CharacterInventoryStorageComponent (slots 0-5: head, jacket, vest, pants, boots, backpack)
+			bool isWeaponStorage = storage.id.Contains("EquipedWeaponStorageComponent");
+			bool isClothingStorage = storage.id.Contains("SCR_CharacterInventoryStorageComponent");
+			
+			foreach (PQD_ParsedLoadoutItem item : storage.items)
+			{
+				if (isWeaponStorage)
+				{
+					SCR_WeaponLoadoutData weaponData = new SCR_WeaponLoadoutData();
+					weaponData.SlotIdx = item.slotIdx;
+					weaponData.WeaponPrefab = item.prefab;
+					weaponData.Active = (item.slotIdx == 0);
+					result.Weapons.Insert(weaponData);
+				}
+				else if (isClothingStorage)
+				{
+					SCR_ClothingLoadoutData clothingData = new SCR_ClothingLoadoutData();
+					clothingData.SlotIdx = item.slotIdx;
+					clothingData.ClothingPrefab = item.prefab;
+					result.Clothings.Insert(clothingData);
+				}
+			}
+		}
+		
+		return result;
+	}
+}
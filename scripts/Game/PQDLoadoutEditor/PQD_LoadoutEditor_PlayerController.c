@@ -5,9 +5,43 @@ class PQD_LoadoutDataTransfer
 	string factionKey;
 	int slotIndex;
 	string prefab;
+	int prefabId = -1;
 	string loadoutData;
 	float cost;
 	string requiredRank;
+	bool resourceNamesEncoded; // loadoutData references PQD_PrefabDictionary IDs
+	
+	//------------------------------------------------------------------------------------------------
+	//! Replace prefab strings with PQD_PrefabDictionary IDs before sending
+	void CompactPrefabs()
+	{
+		prefabId = PQD_PrefabDictionary.GetPrefabId(prefab);
+		if (prefabId != -1)
+			prefab = "";
+		
+		string encoded = PQD_PrefabDictionary.EncodeResourceNames(loadoutData);
+		resourceNamesEncoded = encoded != loadoutData;
+		loadoutData = encoded;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Restore prefab strings from PQD_PrefabDictionary IDs after receiving
+	void ExpandPrefabs()
+	{
+		loadoutData = PQD_LoadoutCompression.Decompress(loadoutData);
+		
+		if (prefabId != -1)
+		{
+			prefab = PQD_PrefabDictionary.GetPrefab(prefabId);
+			prefabId = -1;
+		}
+		
+		if (resourceNamesEncoded)
+		{
+			loadoutData = PQD_PrefabDictionary.DecodeResourceNames(loadoutData);
+			resourceNamesEncoded = false;
+		}
+	}
 }
 
 //------------------------------------------------------------------------------------------------
@@ -19,6 +53,7 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 	// Invokers for responses
 	ref ScriptInvoker m_OnResponse_Storage = new ScriptInvoker();
 	ref ScriptInvoker m_OnResponse_Loadout = new ScriptInvoker();
+	ref ScriptInvoker m_OnResponse_StorageBatch = new ScriptInvoker();
 	
 	// Components
 	PQD_LoadoutStorageComponent m_LoadoutStorageComponent;
@@ -32,6 +67,52 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 	static PQD_PlayerControllerComponent ServerInstance;
 	
 	protected SCR_ArsenalManagerComponent m_arsenalManager;
+	
+	// Server side: PQD_PrefabDictionary version the owning client has acknowledged
+	protected int m_iClientPrefabDictionaryVersion;
+	
+	// Server side: PQD_ClientCapability flags announced by the owning client, 0 for older clients
+	protected int m_iClientCapabilities;
+	
+	// Capabilities this build of the client announces
+	static const int LOCAL_CAPABILITIES = PQD_ClientCapability.LOADOUT_COMPRESSION;
+	
+	// Client side: last sequence id handed out to a request
+	protected int m_iLastSequenceId;
+	
+	// Client side: storage requests sent but not answered yet, sequence id -> action / send time
+	protected ref map<int, PQD_ActionType> m_mInFlightRequests = new map<int, PQD_ActionType>();
+	protected ref map<int, int> m_mInFlightSentAt = new map<int, int>();
+	
+	// Maximum number of storage requests the client keeps in flight
+	static const int MAX_IN_FLIGHT_REQUESTS = 4;
+	
+	// Requests without a response after this long no longer hold a place in the window
+	static const int IN_FLIGHT_TIMEOUT_MS = 15000;
+	
+	// Server side: content versions of each faction the owning client already holds, playable factions only
+	protected ref map<string, int> m_mClientFactionVersions = new map<string, int>();
+	
+	// Server side: factions whose version in m_mClientFactionVersions was confirmed by a sync, not only claimed by the client
+	protected ref array<string> m_aConfirmedFactions = {};
+	
+	// Server side: faction slot requests waiting for a LOADOUT_READ token, in arrival order
+	protected ref array<string> m_aPendingFactionRequests = {};
+	
+	// Maximum number of distinct factions waiting in m_aPendingFactionRequests
+	static const int MAX_PENDING_FACTION_REQUESTS = 8;
+	
+	// Server side: queue of large payloads streamed to the owner
+	protected ref PQD_ChunkedSender m_ChunkedSender;
+	
+	// Client side: chunked payloads being reassembled
+	protected ref PQD_ChunkedReceiver m_ChunkedReceiver = new PQD_ChunkedReceiver();
+	
+	// Server side: rate limits for this player's requests
+	protected ref PQD_RequestThrottle m_RequestThrottle = new PQD_RequestThrottle();
+	
+	// Server side: storage batches waiting on inventory callbacks
+	protected ref array<ref PQD_StorageBatch> m_aActiveStorageBatches = {};
 
 	static ref array<ref PQD_PlayerLoadout> AdminLoadoutMetadata = {};
 
@@ -91,15 +172,218 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 	//------------------------------------------------------------------------------------------------
 	void AskForLoadouts()
 	{
-		Rpc(RpcAsk_LoadoutsPlease);
+		Rpc(RpcAsk_SetClientCapabilities, LOCAL_CAPABILITIES);
+		
+		// Dictionary first - it is queued ahead of every other payload, so later payloads can use IDs
+		Rpc(RpcAsk_PrefabDictionaryPlease, PQD_PrefabDictionary.GetVersion());
+		
+		// Restore the local cache for this server before asking for the initial sync
+		Rpc(RpcAsk_ServerIdentityPlease);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	void RpcAsk_SetClientCapabilities(int capabilities)
+	{
+		m_iClientCapabilities = capabilities;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Server side: does the owning client support an optional payload feature
+	bool ClientHasCapability(PQD_ClientCapability capability)
+	{
+		return (m_iClientCapabilities & capability) != 0;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	void RpcAsk_ServerIdentityPlease()
+	{
+		string serverId;
+		if (m_LoadoutStorageComponent)
+			serverId = m_LoadoutStorageComponent.GetServerId();
+		
+		Rpc(RpcDo_ServerIdentityOwner, serverId);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	void RpcDo_ServerIdentityOwner(string serverId)
+	{
+		// Render instantly from the last session, the sync below reconciles it
+		if (PQD_ClientLoadoutCache.LoadFromProfile(serverId))
+			PQD_ClientLoadoutCache.MarkInitialized();
+		
+		// Loadouts and valid slot data for deploy menu arrive once the server admits us
+		Rpc(RpcAsk_InitialSyncPlease, PQD_ClientLoadoutCache.ExportFactionVersions());
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	void RpcAsk_InitialSyncPlease(string knownVersionsJson)
+	{
+		SCR_JsonLoadContext loadContext = new SCR_JsonLoadContext();
+		map<string, int> knownVersions = new map<string, int>();
+		if (loadContext.ImportFromString(knownVersionsJson))
+			loadContext.ReadValue("versions", knownVersions);
+		
+		foreach (string factionKey, int version : knownVersions)
+		{
+			if (IsPlayableFactionKey(factionKey))
+				m_mClientFactionVersions.Set(factionKey, version);
+		}
+		
+		PQD_InitialSyncScheduler.Enqueue(this);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Server side: called by PQD_InitialSyncScheduler when this player's turn comes
+	void ProcessInitialSync()
+	{
+		SendLoadoutsToOwner();
+		SendValidSlotsToOwner();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	void RpcAsk_PrefabDictionaryPlease(int knownVersion)
+	{
+		PQD_PrefabDictionary.BuildFromCatalogs();
+		m_iClientPrefabDictionaryVersion = PQD_PrefabDictionary.GetVersion();
+		
+		// Client already holds this exact dictionary (e.g. reconnect within the same session)
+		if (knownVersion == m_iClientPrefabDictionaryVersion)
+			return;
 		
-		// Also request valid slot data for deploy menu
-		Rpc(RpcAsk_ValidSlotsPlease);
+		SendPayload(PQD_PayloadKind.PREFAB_DICTIONARY, PQD_PrefabDictionary.ExportToString());
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void ApplyPrefabDictionary(string json)
+	{
+		if (!PQD_PrefabDictionary.ImportFromString(json))
+			Print("[PQD] Failed to parse prefab dictionary", LogLevel.WARNING);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Server side: can payloads for the owning client reference PQD_PrefabDictionary IDs
+	bool ClientHasPrefabDictionary()
+	{
+		return m_iClientPrefabDictionaryVersion != 0 && m_iClientPrefabDictionaryVersion == PQD_PrefabDictionary.GetVersion();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Client side: fetch valid slots and kits of a faction the player is looking at
+	void RequestFactionSlots(string factionKey, int knownVersion)
+	{
+		Rpc(RpcAsk_FactionSlotsPlease, factionKey, knownVersion);
 	}
 	
 	//------------------------------------------------------------------------------------------------
 	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
-	void RpcAsk_ValidSlotsPlease()
+	void RpcAsk_FactionSlotsPlease(string factionKey, int knownVersion)
+	{
+		// Unknown keys are still answered (with no slots) but never remembered
+		if (IsPlayableFactionKey(factionKey))
+			m_mClientFactionVersions.Set(factionKey, knownVersion);
+		
+		if (!m_aPendingFactionRequests.Contains(factionKey))
+		{
+			if (m_aPendingFactionRequests.Count() >= MAX_PENDING_FACTION_REQUESTS)
+			{
+				m_RequestThrottle.CountDropped();
+				return;
+			}
+			
+			m_aPendingFactionRequests.Insert(factionKey);
+		}
+		
+		ProcessPendingFactionRequests();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Answer waiting faction requests while LOADOUT_READ tokens last, retry later for the rest
+	protected void ProcessPendingFactionRequests()
+	{
+		while (!m_aPendingFactionRequests.IsEmpty())
+		{
+			if (!m_RequestThrottle.TryAdmitClass(PQD_RequestClass.LOADOUT_READ))
+			{
+				GetGame().GetCallqueue().Remove(ProcessPendingFactionRequests);
+				GetGame().GetCallqueue().CallLater(ProcessPendingFactionRequests, 500, true);
+				return;
+			}
+			
+			string factionKey = m_aPendingFactionRequests[0];
+			m_aPendingFactionRequests.RemoveOrdered(0);
+			SendValidSlotsToOwner(factionKey);
+		}
+		
+		GetGame().GetCallqueue().Remove(ProcessPendingFactionRequests);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static bool IsPlayableFactionKey(string factionKey)
+	{
+		FactionManager factionManager = GetGame().GetFactionManager();
+		if (!factionManager || factionKey.IsEmpty())
+			return false;
+		
+		SCR_Faction faction = SCR_Faction.Cast(factionManager.GetFactionByKey(factionKey));
+		return faction && faction.IsPlayable();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Content version of a faction's transfers, never 0 so it can't match "unknown"
+	protected static int GetLoadoutTransfersVersion(array<ref PQD_LoadoutDataTransfer> transfers)
+	{
+		int version = 17;
+		foreach (PQD_LoadoutDataTransfer transfer : transfers)
+		{
+			version = version * 31 + transfer.slotIndex;
+			version = version * 31 + transfer.prefab.Hash();
+			version = version * 31 + transfer.loadoutData.Hash();
+			version = version * 31 + transfer.requiredRank.Hash();
+			version = version * 31 + Math.Round(transfer.cost);
+		}
+		
+		if (version == 0)
+			version = 1;
+		
+		return version;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Saved slots of a faction and their kits, uncompacted, in slot order
+	protected void CollectFactionTransfers(int playerId, string factionKey, notnull array<int> validSlots, notnull array<ref PQD_LoadoutDataTransfer> transfers)
+	{
+		// Check each slot (0-4)
+		for (int slotIndex = 0; slotIndex < PQD_PlayerFactionLoadoutStorage.MAX_LOADOUTS_PER_PLAYER; slotIndex++)
+		{
+			string prefab, loadoutData, requiredRank;
+			float cost;
+			
+			if (!m_LoadoutStorageComponent.GetPlayerLoadoutData(playerId, factionKey, slotIndex, prefab, loadoutData, cost, false, requiredRank))
+				continue;
+			
+			validSlots.Insert(slotIndex);
+			
+			// Create transfer object with loadout data
+			PQD_LoadoutDataTransfer transfer = new PQD_LoadoutDataTransfer();
+			transfer.factionKey = factionKey;
+			transfer.slotIndex = slotIndex;
+			transfer.prefab = prefab;
+			transfer.loadoutData = loadoutData;
+			transfer.cost = cost;
+			transfer.requiredRank = requiredRank;
+			
+			transfers.Insert(transfer);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Send valid slots and kits of one faction, the player's own faction when none is given
+	protected void SendValidSlotsToOwner(string requestedFactionKey = "")
 	{
 		// Get player ID and identity for this request
 		int playerId = m_PC.GetPlayerId();
@@ -109,9 +393,9 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		
 		if (!m_LoadoutStorageComponent)
 		{
-			Print("[PQD] RpcAsk_ValidSlotsPlease: StorageComponent not found", LogLevel.WARNING);
+			Print("[PQD] SendValidSlotsToOwner: StorageComponent not found", LogLevel.WARNING);
 			// Send empty response to mark cache as initialized
-			Rpc(RpcDo_UpdateValidSlotsOwner, "{}");
+			SendPayload(PQD_PayloadKind.VALID_SLOTS, "{}");
 			return;
 		}
 		
@@ -119,22 +403,37 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		FactionManager factionManager = GetGame().GetFactionManager();
 		if (!factionManager)
 		{
-			Print("[PQD] RpcAsk_ValidSlotsPlease: FactionManager not found", LogLevel.WARNING);
-			Rpc(RpcDo_UpdateValidSlotsOwner, "{}");
+			Print("[PQD] SendValidSlotsToOwner: FactionManager not found", LogLevel.WARNING);
+			SendPayload(PQD_PayloadKind.VALID_SLOTS, "{}");
 			return;
 		}
 		
+		// Other factions are fetched on demand when the deploy menu shows them
 		array<Faction> factions = {};
-		factionManager.GetFactionsList(factions);
+		if (!requestedFactionKey.IsEmpty())
+		{
+			Faction requestedFaction = factionManager.GetFactionByKey(requestedFactionKey);
+			if (requestedFaction)
+				factions.Insert(requestedFaction);
+		}
+		else
+		{
+			Faction playerFaction = SCR_FactionManager.SGetPlayerFaction(playerId);
+			if (playerFaction)
+				factions.Insert(playerFaction);
+		}
 		
 		// Build response with valid slots per faction AND loadout data
 		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
 		
 		ref map<string, ref array<int>> validSlotsMap = new map<string, ref array<int>>();
+		ref map<string, int> versionsMap = new map<string, int>();
 		
 		// Also collect loadout data to send to client for preview
 		// Format: array of { factionKey, slotIndex, prefab, loadoutData, cost, requiredRank }
 		ref array<ref PQD_LoadoutDataTransfer> loadoutDataArray = new array<ref PQD_LoadoutDataTransfer>();
+		bool usePrefabIds = ClientHasPrefabDictionary();
+		bool useCompression = ClientHasCapability(PQD_ClientCapability.LOADOUT_COMPRESSION);
 		
 		foreach (Faction faction : factions)
 		{
@@ -144,48 +443,59 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 			
 			string factionKey = scrFaction.GetFactionKey();
 			ref array<int> validSlots = new array<int>();
+			array<ref PQD_LoadoutDataTransfer> factionTransfers = {};
+			CollectFactionTransfers(playerId, factionKey, validSlots, factionTransfers);
+			
+			validSlotsMap.Set(factionKey, validSlots);
 			
-			// Check each slot (0-4)
-			for (int slotIndex = 0; slotIndex < 5; slotIndex++)
+			// Client restored this exact content from its profile cache - skip the kits
+			int version = GetLoadoutTransfersVersion(factionTransfers);
+			versionsMap.Set(factionKey, version);
+			if (m_mClientFactionVersions.Get(factionKey) != version)
 			{
-				string prefab, loadoutData, requiredRank;
-				float cost;
-				
-				if (m_LoadoutStorageComponent.GetPlayerLoadoutData(playerId, factionKey, slotIndex, prefab, loadoutData, cost, false, requiredRank))
+				foreach (PQD_LoadoutDataTransfer factionTransfer : factionTransfers)
 				{
-					validSlots.Insert(slotIndex);
+					if (usePrefabIds)
+						factionTransfer.CompactPrefabs();
 					
-					// Create transfer object with loadout data
-					ref PQD_LoadoutDataTransfer transfer = new PQD_LoadoutDataTransfer();
-					transfer.factionKey = factionKey;
-					transfer.slotIndex = slotIndex;
-					transfer.prefab = prefab;
-					transfer.loadoutData = loadoutData;
-					transfer.cost = cost;
-					transfer.requiredRank = requiredRank;
-					loadoutDataArray.Insert(transfer);
+					if (useCompression)
+						factionTransfer.loadoutData = PQD_LoadoutCompression.Compress(factionTransfer.loadoutData);
+					
+					loadoutDataArray.Insert(factionTransfer);
 				}
+				
+				m_mClientFactionVersions.Set(factionKey, version);
 			}
 			
-			validSlotsMap.Set(factionKey, validSlots);
+			if (!m_aConfirmedFactions.Contains(factionKey))
+				m_aConfirmedFactions.Insert(factionKey);
+			
 			Print(string.Format("[PQD] Faction %1 has %2 valid slots", factionKey, validSlots.Count()), LogLevel.DEBUG);
 		}
 		
+		// Always answer the requested key, the client marks it synced and stops asking
+		if (!requestedFactionKey.IsEmpty() && !validSlotsMap.Contains(requestedFactionKey))
+			validSlotsMap.Set(requestedFactionKey, new array<int>());
+		
+		// Valid slots first so the deploy menu can filter slots before any kit arrives
 		saveContext.WriteValue("validSlots", validSlotsMap);
-		saveContext.WriteValue("loadoutData", loadoutDataArray);
-		string response = saveContext.ExportToString();
+		saveContext.WriteValue("versions", versionsMap);
+		SendPayload(PQD_PayloadKind.VALID_SLOTS, saveContext.ExportToString());
+		
+		foreach (PQD_LoadoutDataTransfer transfer : loadoutDataArray)
+		{
+			SCR_JsonSaveContext transferContext = new SCR_JsonSaveContext();
+			transferContext.WriteValue("", transfer);
+			SendPayload(PQD_PayloadKind.LOADOUT_DATA, transferContext.ExportToString());
+		}
 		
-		Print(string.Format("[PQD] Sending valid slots and loadout data to player %1 (%2 loadouts)", playerId, loadoutDataArray.Count()), LogLevel.NORMAL);
-		Rpc(RpcDo_UpdateValidSlotsOwner, response);
+		Print(string.Format("[PQD] Streaming valid slots and loadout data to player %1 (%2 loadouts)", playerId, loadoutDataArray.Count()), LogLevel.NORMAL);
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
-	void RpcDo_UpdateValidSlotsOwner(string json)
+	//! Client side: valid slots part of the initial sync
+	protected void ApplyValidSlots(string json)
 	{
-		Print(string.Format("[PQD] Received loadout data from server (size: %1 bytes)", json.Length()), LogLevel.NORMAL);
-		
-		// Parse the response
 		SCR_JsonLoadContext loadContext = new SCR_JsonLoadContext();
 		if (!loadContext.ImportFromString(json))
 		{
@@ -198,50 +508,125 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		ref map<string, ref array<int>> validSlotsMap = new map<string, ref array<int>>();
 		loadContext.ReadValue("validSlots", validSlotsMap);
 		
+		// Content version per faction - kits of changed factions follow this payload
+		ref map<string, int> versionsMap = new map<string, int>();
+		loadContext.ReadValue("versions", versionsMap);
+		
 		// Update the client cache with valid slots
 		foreach (string factionKey, array<int> slots : validSlotsMap)
 		{
+			PQD_ClientLoadoutCache.SetFactionVersion(factionKey, versionsMap.Get(factionKey));
 			PQD_ClientLoadoutCache.UpdateCache(factionKey, slots);
 		}
 		
-		// Read and cache loadout data for preview
-		ref array<ref PQD_LoadoutDataTransfer> loadoutDataArray = new array<ref PQD_LoadoutDataTransfer>();
-		loadContext.ReadValue("loadoutData", loadoutDataArray);
-		
-		Print(string.Format("[PQD] Received %1 loadout data entries", loadoutDataArray.Count()), LogLevel.NORMAL);
+		// Mark cache as initialized even if empty, kits for preview keep streaming in
+		PQD_ClientLoadoutCache.MarkInitialized();
+		PQD_ClientLoadoutCache.ScheduleSaveToProfile();
 		
-		foreach (PQD_LoadoutDataTransfer transfer : loadoutDataArray)
+		Print(string.Format("[PQD] Received valid slots for %1 factions", validSlotsMap.Count()), LogLevel.NORMAL);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Client side: one kit of the initial sync, cached for preview
+	protected void ApplyLoadoutData(string json)
+	{
+		SCR_JsonLoadContext loadContext = new SCR_JsonLoadContext();
+		if (!loadContext.ImportFromString(json))
 		{
-			if (transfer)
-			{
-				PQD_ClientLoadoutCache.SetLoadoutData(
-					transfer.factionKey, 
-					transfer.slotIndex, 
-					transfer.prefab, 
-					transfer.loadoutData, 
-					transfer.cost, 
-					transfer.requiredRank
-				);
-				Print(string.Format("[PQD] Cached loadout: %1 slot %2", transfer.factionKey, transfer.slotIndex), LogLevel.DEBUG);
-			}
+			Print("[PQD] Failed to parse loadout data JSON", LogLevel.WARNING);
+			return;
 		}
 		
-		// Mark cache as initialized even if empty
-		PQD_ClientLoadoutCache.MarkInitialized();
+		PQD_LoadoutDataTransfer transfer = new PQD_LoadoutDataTransfer();
+		if (!loadContext.ReadValue("", transfer))
+			return;
 		
-		Print("[PQD] Client loadout cache updated successfully with data", LogLevel.NORMAL);
+		transfer.ExpandPrefabs();
+		PQD_ClientLoadoutCache.SetLoadoutData(
+			transfer.factionKey, 
+			transfer.slotIndex, 
+			transfer.prefab, 
+			transfer.loadoutData, 
+			transfer.cost, 
+			transfer.requiredRank
+		);
+		PQD_ClientLoadoutCache.ScheduleSaveToProfile();
+		Print(string.Format("[PQD] Cached loadout: %1 slot %2", transfer.factionKey, transfer.slotIndex), LogLevel.DEBUG);
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
-	void RpcAsk_LoadoutsPlease()
+	//! Server side: stream a payload to the owner at a bounded rate
+	//! Every server -> owner message goes through here, see PQD_ChunkedSender.Send for the delivery order
+	protected void SendPayload(PQD_PayloadKind kind, string data)
+	{
+		if (!m_ChunkedSender)
+			m_ChunkedSender = new PQD_ChunkedSender(this);
+		
+		m_ChunkedSender.Send(kind, data);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called by PQD_ChunkedSender
+	void SendPayloadHeader(int payloadId, PQD_PayloadKind kind, int chunkCount, int length, int checksum)
+	{
+		Rpc(RpcDo_PayloadHeaderOwner, payloadId, kind, chunkCount, length, checksum);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called by PQD_ChunkedSender
+	void SendPayloadChunk(int payloadId, int index, string chunk)
+	{
+		Rpc(RpcDo_PayloadChunkOwner, payloadId, index, chunk);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	void RpcDo_PayloadHeaderOwner(int payloadId, int kind, int chunkCount, int length, int checksum)
+	{
+		m_ChunkedReceiver.OnHeader(payloadId, kind, chunkCount, length, checksum);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	void RpcDo_PayloadChunkOwner(int payloadId, int index, string chunk)
+	{
+		PQD_PayloadKind kind;
+		string data;
+		if (!m_ChunkedReceiver.OnChunk(payloadId, index, chunk, kind, data))
+			return;
+		
+		switch (kind)
+		{
+			case PQD_PayloadKind.ACTION_RESPONSE:
+				ApplyActionResponse(data);
+				break;
+			case PQD_PayloadKind.VALID_SLOTS:
+				ApplyValidSlots(data);
+				break;
+			case PQD_PayloadKind.LOADOUT_DATA:
+				ApplyLoadoutData(data);
+				break;
+			case PQD_PayloadKind.ADMIN_LOADOUTS:
+				RpcDo_UpdateLoadoutsOwner(data);
+				break;
+			case PQD_PayloadKind.SLOT_UPDATE:
+				ApplySlotUpdate(data);
+				break;
+			case PQD_PayloadKind.PREFAB_DICTIONARY:
+				ApplyPrefabDictionary(data);
+				break;
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void SendLoadoutsToOwner()
 	{
 		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
 		saveContext.WriteValue("", AdminLoadoutMetadata);
 		
 		string loadoutsJson = saveContext.ExportToString();
 		
-		Rpc(RpcDo_UpdateLoadoutsOwner, loadoutsJson);
+		SendPayload(PQD_PayloadKind.ADMIN_LOADOUTS, loadoutsJson);
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -297,15 +682,77 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 	}
 
 	//------------------------------------------------------------------------------------------------
-	void RequestAction(PQD_StorageRequest request)
+	//! Tag a request with the next client sequence id
+	int AssignSequenceId(PQD_NetworkRequest request)
+	{
+		m_iLastSequenceId++;
+		request.sequenceId = m_iLastSequenceId;
+		return m_iLastSequenceId;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetInFlightRequestCount()
+	{
+		ExpireInFlightRequests();
+		return m_mInFlightRequests.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! False while the in-flight window is full
+	bool CanSendRequest()
+	{
+		ExpireInFlightRequests();
+		return m_mInFlightRequests.Count() < MAX_IN_FLIGHT_REQUESTS;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void TrackInFlightRequest(PQD_NetworkRequest request, PQD_ActionType actionType)
+	{
+		m_mInFlightRequests.Set(request.sequenceId, actionType);
+		m_mInFlightSentAt.Set(request.sequenceId, System.GetTickCount());
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! A lost response must not block the window forever
+	protected void ExpireInFlightRequests()
+	{
+		if (m_mInFlightSentAt.IsEmpty())
+			return;
+		
+		int now = System.GetTickCount();
+		array<int> expired = {};
+		foreach (int sequenceId, int sentAt : m_mInFlightSentAt)
+		{
+			if (now - sentAt > IN_FLIGHT_TIMEOUT_MS)
+				expired.Insert(sequenceId);
+		}
+		
+		foreach (int sequenceId : expired)
+		{
+			Print(string.Format("[PQD] Request #%1 timed out without a response", sequenceId), LogLevel.WARNING);
+			m_mInFlightRequests.Remove(sequenceId);
+			m_mInFlightSentAt.Remove(sequenceId);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Returns the sequence id the response will carry
+	int RequestAction(PQD_StorageRequest request)
 	{
+		AssignSequenceId(request);
+		TrackInFlightRequest(request, request.actionType);
+		request.CompactPrefab();
+		
 		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
 		saveContext.WriteValue("", request);
 
 		string requestString = saveContext.ExportToString();
+		request.ExpandPrefab();
 		
 		Print(string.Format("[PQD] Sending storage request: %1", requestString), LogLevel.DEBUG);
 		Rpc(RpcAsk_RequestAction, requestString);
+		
+		return request.sequenceId;
 	}
 
 	//------------------------------------------------------------------------------------------------
@@ -321,6 +768,77 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		
 		Print(string.Format("[PQD] Processing request from player %1: %2", playerId, requestJson), LogLevel.DEBUG);
 		
+		if (request.prefabId != -1)
+		{
+			request.ExpandPrefab();
+			if (request.prefab.IsEmpty())
+			{
+				SendActionResponse(request, false, "Unknown prefab");
+				return;
+			}
+		}
+		
+		// Slot requests queue behind deferred ones, a newer change must never overtake an older one
+		if (PQD_RequestThrottle.IsSlotAction(request.actionType) && m_RequestThrottle.HasDeferred())
+		{
+			ThrottleStorageRequest(request);
+			return;
+		}
+		
+		if (!m_RequestThrottle.TryAdmit(request))
+		{
+			ThrottleStorageRequest(request);
+			return;
+		}
+		
+		ExecuteStorageRequest(request);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Defer a throttled slot request (latest replacement per slot wins), reject anything else
+	protected void ThrottleStorageRequest(PQD_StorageRequest request)
+	{
+		if (!PQD_RequestThrottle.IsSlotAction(request.actionType))
+		{
+			m_RequestThrottle.CountDropped();
+			SendActionResponse(request, false, "Too many requests, slow down");
+			return;
+		}
+		
+		PQD_StorageRequest superseded;
+		if (!m_RequestThrottle.Defer(request, superseded))
+		{
+			m_RequestThrottle.CountDropped();
+			SendActionResponse(request, false, "Too many requests, slow down");
+			return;
+		}
+		
+		if (superseded)
+			SendActionResponse(superseded, false, "Superseded by a newer request");
+		
+		GetGame().GetCallqueue().Remove(ProcessDeferredStorageRequests);
+		GetGame().GetCallqueue().CallLater(ProcessDeferredStorageRequests, 100, true);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void ProcessDeferredStorageRequests()
+	{
+		PQD_StorageRequest request = m_RequestThrottle.PopDeferred();
+		while (request)
+		{
+			ExecuteStorageRequest(request);
+			request = m_RequestThrottle.PopDeferred();
+		}
+		
+		if (!m_RequestThrottle.HasDeferred())
+			GetGame().GetCallqueue().Remove(ProcessDeferredStorageRequests);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void ExecuteStorageRequest(PQD_StorageRequest request)
+	{
+		int playerId = m_PC.GetPlayerId();
+		
 		// Handle visual identity change
 		if (request.actionType == PQD_ActionType.CHANGE_VISUAL_IDENTITY)
 		{
@@ -363,6 +881,13 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		}
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Server side: rate limiter counters for this player
+	PQD_RequestThrottle GetRequestThrottle()
+	{
+		return m_RequestThrottle;
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	void HandleVisualIdentityChange(PQD_StorageRequest request, int playerId)
 	{
@@ -373,21 +898,20 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 			return;
 		}
 
-		IEntity arsenalEntity = PQD_Helpers.GetEntityFromRplId(request.arsenalEntityRplId);
-		if (!arsenalEntity)
+		PQD_ArsenalContext arsenal = PQD_ArsenalContext.Get(request.arsenalEntityRplId);
+		if (!arsenal)
 		{
 			SendActionResponse(request, false, "Could not find arsenal entity");
 			return;
 		}
 		
-		SCR_FactionAffiliationComponent arsenalFactionComp = SCR_FactionAffiliationComponent.Cast(arsenalEntity.FindComponent(SCR_FactionAffiliationComponent));
-		if (!arsenalFactionComp)
+		if (!arsenal.factionAffiliation)
 		{
 			SendActionResponse(request, false, "Could not find faction component");
 			return;
 		}
 		
-		Faction arsenalFaction = arsenalFactionComp.GetAffiliatedFaction();
+		Faction arsenalFaction = arsenal.factionAffiliation.GetAffiliatedFaction();
 		if (!arsenalFaction)
 		{
 			SendActionResponse(request, false, "Could not find arsenal faction");
@@ -427,40 +951,31 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		if (!SCR_ResourceSystemHelper.IsGlobalResourceTypeEnabled())
 			return true;
 
-		IEntity arsenalEntity = PQD_Helpers.GetEntityFromRplId(request.arsenalEntityRplId);
-		if (!arsenalEntity)
-		{
-			SendActionResponse(request, false, "Cannot find Arsenal Entity");
-			return false;
-		}
-
-		SCR_ArsenalComponent arsenalComponent = SCR_ArsenalComponent.Cast(arsenalEntity.FindComponent(SCR_ArsenalComponent));
-		if (!arsenalComponent)
+		PQD_ArsenalContext arsenal = PQD_ArsenalContext.Get(request.arsenalEntityRplId);
+		if (!arsenal)
 		{
 			SendActionResponse(request, false, "Cannot find Arsenal Component");
 			return false;
 		}
 		
-		cost = PQD_Helpers.GetItemSupplyCost(arsenalComponent, request.prefab);
+		cost = arsenal.GetItemSupplyCost(request.prefab);
 		if (cost < 0.1)
 			return true;
 
-		SCR_ResourceComponent resourceComponent = SCR_ResourceComponent.FindResourceComponent(arsenalEntity);
-		if (!resourceComponent)
+		if (!arsenal.resourceComponent)
 		{
 			SendActionResponse(request, false, "Cannot find Resource Component");
 			return false;
 		}
 		
-		SCR_ResourceConsumer consumer = resourceComponent.GetConsumer(EResourceGeneratorID.DEFAULT, EResourceType.SUPPLIES);
-		if (!consumer)
+		if (!arsenal.consumer)
 		{
 			SendActionResponse(request, false, "Cannot find Resource Consumer");
 			return false;
 		}
 		
-		cost *= consumer.GetBuyMultiplier();
-		SCR_ResourceConsumtionResponse resp = consumer.RequestConsumtion(cost);
+		cost *= arsenal.consumer.GetBuyMultiplier();
+		SCR_ResourceConsumtionResponse resp = arsenal.consumer.RequestConsumtion(cost);
 		bool success = resp.GetReason() == EResourceReason.SUFFICIENT;
 		
 		if (!success)
@@ -475,22 +990,15 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		if (m_arsenalManager && !m_arsenalManager.AreItemsRankLocked())
 			return true;
 
-		IEntity arsenalEntity = PQD_Helpers.GetEntityFromRplId(request.arsenalEntityRplId);
-		if (!arsenalEntity)
-		{
-			SendActionResponse(request, false, "Cannot find Arsenal Entity");
-			return false;
-		}
-		
-		SCR_ArsenalComponent arsenalComponent = SCR_ArsenalComponent.Cast(arsenalEntity.FindComponent(SCR_ArsenalComponent));
-		if (!arsenalComponent)
+		PQD_ArsenalContext arsenal = PQD_ArsenalContext.Get(request.arsenalEntityRplId);
+		if (!arsenal)
 		{
 			SendActionResponse(request, false, "Cannot find Arsenal Component");
 			return false;
 		}
 
 		SCR_ECharacterRank playerRank = SCR_CharacterRankComponent.GetCharacterRank(SCR_PlayerController.Cast(GetOwner()).GetControlledEntity());
-		SCR_ECharacterRank rankRequired = PQD_Helpers.GetItemRequiredRank(arsenalComponent, request.prefab);
+		SCR_ECharacterRank rankRequired = arsenal.GetItemRequiredRank(request.prefab);
 
 		if (playerRank == SCR_ECharacterRank.INVALID || rankRequired == SCR_ECharacterRank.INVALID)
 			return true;
@@ -515,6 +1023,13 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		if (!HasHighEnoughRank(request))
 			return;
 		
+		string feasibilityKey = PQD_InsertFeasibilityMemo.GetKey(storage, request.prefab);
+		if (PQD_InsertFeasibilityMemo.IsKnownInfeasible(feasibilityKey))
+		{
+			SendActionResponse(request, false, "Failed to find suitable storage");
+			return;
+		}
+		
 		IEntity itemEntity = PQD_Helpers.PrepareTemporaryEntityAtCoords(request.prefab, storageManager.GetOwner().GetOrigin());
 		if (!itemEntity)
 		{
@@ -525,6 +1040,7 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		BaseInventoryStorageComponent appropriateStorage = storageManager.FindStorageForInsert(itemEntity, storage, EStoragePurpose.PURPOSE_ANY);
 		if (!appropriateStorage)
 		{
+			RecordFailedStorageSearch(feasibilityKey, storage);
 			SendActionResponse(request, false, "Failed to find suitable storage");
 			SCR_EntityHelper.DeleteEntityAndChildren(itemEntity);
 			return;
@@ -548,34 +1064,42 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		storageManager.TryInsertItemInStorage(itemEntity, appropriateStorage, -1, deleteCb);
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! A storage that holds nothing and still has no room for the item never will
+	protected void RecordFailedStorageSearch(string feasibilityKey, BaseInventoryStorageComponent storage)
+	{
+		array<IEntity> storedItems = {};
+		if (storage.GetAll(storedItems) == 0)
+			PQD_InsertFeasibilityMemo.RecordFailure(feasibilityKey);
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	protected bool TryRefundItem(PQD_StorageRequest request, IEntity attachedEntity, out float refund)
 	{
-		IEntity arsenalEntity = PQD_Helpers.GetEntityFromRplId(request.arsenalEntityRplId);
-		if (!arsenalEntity)
-		{
-			SendActionResponse(request, false, "Invalid arsenal entity");
-			return false;
-		}
-
-		SCR_ArsenalComponent arsenalComponent = SCR_ArsenalComponent.Cast(arsenalEntity.FindComponent(SCR_ArsenalComponent));
-		if (!arsenalComponent)
+		PQD_ArsenalContext arsenal = PQD_ArsenalContext.Get(request.arsenalEntityRplId);
+		if (!arsenal)
 		{
 			SendActionResponse(request, false, "Invalid arsenal component");
 			return false;
 		}
 		
-		refund = Math.Clamp(SCR_ArsenalManagerComponent.GetItemRefundAmount(attachedEntity, arsenalComponent, false), 0, float.MAX);
+		refund = RefundItemToArsenal(arsenal, attachedEntity);
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected float RefundItemToArsenal(PQD_ArsenalContext arsenal, IEntity attachedEntity)
+	{
+		float refund = Math.Clamp(SCR_ArsenalManagerComponent.GetItemRefundAmount(attachedEntity, arsenal.arsenalComponent, false), 0, float.MAX);
 		
 		InventoryItemComponent inventoryItemComponent = InventoryItemComponent.Cast(attachedEntity.FindComponent(InventoryItemComponent));
-		SCR_ResourceComponent resourceComponent = SCR_ResourceComponent.FindResourceComponent(arsenalEntity);
-		if (resourceComponent)
+		if (arsenal.resourceComponent)
 		{
 			auto resourceInventoryComponent = SCR_ResourcePlayerControllerInventoryComponent.Cast(GetOwner().FindComponent(SCR_ResourcePlayerControllerInventoryComponent));
-			resourceInventoryComponent.RpcAsk_ArsenalRefundItem(Replication.FindId(resourceComponent), Replication.FindId(inventoryItemComponent), EResourceType.SUPPLIES);
+			resourceInventoryComponent.RpcAsk_ArsenalRefundItem(Replication.FindId(arsenal.resourceComponent), Replication.FindId(inventoryItemComponent), EResourceType.SUPPLIES);
 		}
 		
-		return true;
+		return refund;
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -647,7 +1171,7 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		
 		if (!HasHighEnoughRank(request))
 			return;
-
+		
 		float cost;
 		if (!CanAffordItem(request, cost))
 			return;
@@ -703,16 +1227,364 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		Print(string.Format("[PQD] Response: %1, success: %2, message: %3", request.Repr(), success, message), LogLevel.DEBUG);
 		
 		PQD_NetworkResponse response = new PQD_NetworkResponse();
-		response.request = request;
-		response.success = success;
+		response.request = request;
+		response.success = success;
+		response.message = message;
+		
+		// Echo the prefab back as an ID when the client can resolve it
+		PQD_StorageRequest storageRequest = PQD_StorageRequest.Cast(request);
+		if (storageRequest && ClientHasPrefabDictionary())
+			storageRequest.CompactPrefab();
+		
+		SendResponse(response);
+		
+		if (storageRequest)
+			storageRequest.ExpandPrefab();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void SendResponse(PQD_NetworkResponse response)
+	{
+		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
+		saveContext.WriteValue("", response);
+		
+		// Small responses too, so they never overtake a loadout list or slot update still being streamed
+		SendPayload(PQD_PayloadKind.ACTION_RESPONSE, saveContext.ExportToString());
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	// Storage batch operations
+	int RequestStorageBatch(PQD_StorageBatchRequest request)
+	{
+		AssignSequenceId(request);
+		TrackInFlightRequest(request, request.actionType);
+		request.CompactPrefabs();
+		
+		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
+		saveContext.WriteValue("", request);
+
+		string requestString = saveContext.ExportToString();
+		request.ExpandPrefabs();
+		
+		Print(string.Format("[PQD] Sending storage batch: %1", request.Repr()), LogLevel.DEBUG);
+		Rpc(RpcAsk_RequestStorageBatch, requestString);
+		
+		return request.sequenceId;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	void RpcAsk_RequestStorageBatch(string requestJson)
+	{
+		int playerId = m_PC.GetPlayerId();
+		
+		PQD_StorageBatchRequest request = new PQD_StorageBatchRequest();
+		SCR_JsonLoadContext loadContext = new SCR_JsonLoadContext();
+		loadContext.ImportFromString(requestJson);
+		loadContext.ReadValue("", request);
+		request.ExpandPrefabs();
+		
+		Print(string.Format("[PQD] Processing storage batch from player %1: %2", playerId, request.Repr()), LogLevel.DEBUG);
+		
+		// A batch would run ahead of the deferred slot requests sent before it
+		if (m_RequestThrottle.HasDeferred())
+		{
+			m_RequestThrottle.CountDropped();
+			SendActionResponse(request, false, "Previous changes still pending, try again");
+			return;
+		}
+		
+		if (!m_RequestThrottle.TryAdmit(request))
+		{
+			m_RequestThrottle.CountDropped();
+			SendActionResponse(request, false, "Too many requests, slow down");
+			return;
+		}
+		
+		PQD_StorageBatch batch = new PQD_StorageBatch(this, request);
+		
+		batch.storageManager = GetPlayerInventoryManager(playerId);
+		if (!batch.storageManager)
+		{
+			batch.FailPending("Character storage manager not found");
+			SendStorageBatchResponse(batch);
+			return;
+		}
+		
+		batch.arsenal = PQD_ArsenalContext.Get(request.arsenalEntityRplId);
+		if (!batch.arsenal)
+		{
+			batch.FailPending("Cannot find Arsenal Component");
+			SendStorageBatchResponse(batch);
+			return;
+		}
+		
+		// Validation pass - everything that can be rejected without touching the inventory
+		foreach (int i, PQD_StorageRequest operation : request.operations)
+		{
+			string error = ValidateStorageBatchOperation(operation);
+			if (!error.IsEmpty())
+				batch.SetResult(i, false, error);
+		}
+		
+		// Single rank check against the player's current rank
+		if (m_arsenalManager && m_arsenalManager.AreItemsRankLocked())
+		{
+			SCR_ECharacterRank playerRank = SCR_CharacterRankComponent.GetCharacterRank(m_PC.GetControlledEntity());
+			if (playerRank != SCR_ECharacterRank.INVALID)
+			{
+				string playerAsString = typename.EnumToString(SCR_ECharacterRank, playerRank);
+				playerAsString.ToLower();
+				
+				foreach (int i, PQD_StorageRequest operation : request.operations)
+				{
+					if (!batch.IsPending(i) || operation.actionType == PQD_ActionType.REMOVE_ITEM)
+						continue;
+					
+					SCR_ECharacterRank rankRequired = batch.arsenal.GetItemRequiredRank(operation.prefab);
+					if (rankRequired == SCR_ECharacterRank.INVALID || playerRank >= rankRequired)
+						continue;
+					
+					string requiredAsString = typename.EnumToString(SCR_ECharacterRank, rankRequired);
+					requiredAsString.ToLower();
+					batch.SetResult(i, false, string.Format("%1 rank required (you are %2)", requiredAsString, playerAsString));
+				}
+			}
+		}
+		
+		// Draft commits run only if every operation validates, the inventory pass itself is not rolled back
+		if (request.validateAll)
+		{
+			string firstError = batch.GetFirstError();
+			if (!firstError.IsEmpty())
+			{
+				batch.FailPending(string.Format("Rejected: %1", firstError));
+				SendStorageBatchResponse(batch);
+				return;
+			}
+		}
+		
+		// Single supply charge for everything that is going to be inserted
+		if (SCR_ResourceSystemHelper.IsGlobalResourceTypeEnabled())
+		{
+			float cost;
+			foreach (int i, PQD_StorageRequest operation : request.operations)
+			{
+				if (batch.IsPending(i) && operation.actionType != PQD_ActionType.REMOVE_ITEM)
+					cost += batch.arsenal.GetItemSupplyCost(operation.prefab);
+			}
+			
+			if (cost >= 0.1)
+			{
+				SCR_ResourceConsumer consumer = batch.arsenal.consumer;
+				if (!consumer)
+				{
+					batch.FailPending("Cannot find Resource Consumer");
+					SendStorageBatchResponse(batch);
+					return;
+				}
+				
+				cost *= consumer.GetBuyMultiplier();
+				SCR_ResourceConsumtionResponse resp = consumer.RequestConsumtion(cost);
+				if (resp.GetReason() != EResourceReason.SUFFICIENT)
+				{
+					batch.FailPending(string.Format("Not enough supplies (cost: %1)", cost));
+					SendStorageBatchResponse(batch);
+					return;
+				}
+				
+				batch.totalCost = cost;
+			}
+		}
+		
+		// Inventory pass - operations run in order, each one waits for the previous callback
+		m_aActiveStorageBatches.Insert(batch);
+		batch.ProcessNext();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Returns an error message, empty if the operation can be executed
+	protected string ValidateStorageBatchOperation(PQD_StorageRequest operation)
+	{
+		if (operation.actionType != PQD_ActionType.ADD_ITEM && operation.actionType != PQD_ActionType.REMOVE_ITEM && operation.actionType != PQD_ActionType.REPLACE_ITEM)
+			return "Action not supported in batch";
+		
+		if (operation.actionType != PQD_ActionType.REMOVE_ITEM && operation.prefab.IsEmpty())
+			return "Unknown prefab";
+		
+		BaseInventoryStorageComponent storage = BaseInventoryStorageComponent.Cast(Replication.FindItem(operation.storageRplId));
+		if (!storage)
+			return "Provided entity is not a storage component";
+		
+		if (operation.actionType == PQD_ActionType.ADD_ITEM)
+		{
+			if (PQD_InsertFeasibilityMemo.IsKnownInfeasible(PQD_InsertFeasibilityMemo.GetKey(storage, operation.prefab)))
+				return "Failed to find suitable storage";
+			
+			return string.Empty;
+		}
+		
+		InventoryStorageSlot slot = storage.GetSlot(operation.storageSlotId);
+		if (!slot)
+			return "Requested slot does not exist";
+		
+		if (operation.actionType == PQD_ActionType.REMOVE_ITEM && !slot.GetAttachedEntity())
+			return "Provided entity is invalid";
+		
+		return string.Empty;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called by PQD_StorageBatch for each operation that passed validation
+	void ExecuteStorageBatchOperation(PQD_StorageBatch batch, PQD_StorageRequest operation)
+	{
+		// Resolve again - earlier operations may have removed the container this one targets
+		BaseInventoryStorageComponent storage = BaseInventoryStorageComponent.Cast(Replication.FindItem(operation.storageRplId));
+		if (!storage)
+		{
+			batch.OnOperationFinished(false, "Storage no longer exists");
+			return;
+		}
+		
+		SCR_InventoryStorageManagerComponent storageManager = batch.storageManager;
+		if (!storageManager)
+		{
+			batch.OnOperationFinished(false, "Character storage manager not found");
+			return;
+		}
+		
+		if (operation.actionType == PQD_ActionType.ADD_ITEM)
+		{
+			IEntity itemEntity = PQD_Helpers.PrepareTemporaryEntityAtCoords(operation.prefab, storageManager.GetOwner().GetOrigin());
+			if (!itemEntity)
+			{
+				batch.OnOperationFinished(false, "Failed to spawn temporary entity");
+				return;
+			}
+			
+			BaseInventoryStorageComponent appropriateStorage = storageManager.FindStorageForInsert(itemEntity, storage, EStoragePurpose.PURPOSE_ANY);
+			if (!appropriateStorage)
+			{
+				RecordFailedStorageSearch(PQD_InsertFeasibilityMemo.GetKey(storage, operation.prefab), storage);
+				SCR_EntityHelper.DeleteEntityAndChildren(itemEntity);
+				batch.OnOperationFinished(false, "Failed to find suitable storage");
+				return;
+			}
+			
+			PQD_InvCallback_DeleteOnFail addCb = new PQD_InvCallback_DeleteOnFail();
+			addCb.messageOk = "Item added";
+			addCb.messageFailed = "Failed to add item to storage";
+			addCb.temporaryEntity = itemEntity;
+			addCb.component = this;
+			addCb.request = operation;
+			addCb.batch = batch;
+			
+			storageManager.TryInsertItemInStorage(itemEntity, appropriateStorage, -1, addCb);
+			return;
+		}
+		
+		InventoryStorageSlot slot = storage.GetSlot(operation.storageSlotId);
+		if (!slot)
+		{
+			batch.OnOperationFinished(false, "Requested slot does not exist");
+			return;
+		}
+		
+		IEntity attachedEntity = slot.GetAttachedEntity();
+		if (attachedEntity && batch.refundRemovedItems)
+			batch.totalRefund += RefundItemToArsenal(batch.arsenal, attachedEntity);
+		
+		if (operation.actionType == PQD_ActionType.REMOVE_ITEM)
+		{
+			if (!attachedEntity)
+			{
+				batch.OnOperationFinished(true, "Item removed");
+				return;
+			}
+			
+			PQD_InvCallback removeCb = new PQD_InvCallback();
+			removeCb.messageOk = "Item removed";
+			removeCb.messageFailed = "Failed to remove item from storage";
+			removeCb.request = operation;
+			removeCb.component = this;
+			removeCb.batch = batch;
+			
+			storageManager.TryDeleteItem(attachedEntity, removeCb);
+			return;
+		}
+		
+		if (!attachedEntity)
+		{
+			IEntity newEntity = PQD_Helpers.PrepareTemporaryEntityAtCoords(operation.prefab, storageManager.GetOwner().GetOrigin());
+			if (!newEntity)
+			{
+				batch.OnOperationFinished(false, "Failed to spawn temporary entity");
+				return;
+			}
+			
+			PQD_InvCallback_DeleteOnFail insertCb = new PQD_InvCallback_DeleteOnFail();
+			insertCb.messageOk = "Item added";
+			insertCb.messageFailed = "Failed to add item to storage";
+			insertCb.temporaryEntity = newEntity;
+			insertCb.component = this;
+			insertCb.request = operation;
+			insertCb.batch = batch;
+			
+			storageManager.TryInsertItemInStorage(newEntity, storage, operation.storageSlotId, insertCb);
+			return;
+		}
+		
+		PQD_InvCallback_SpawnAfterDelete replaceCb = new PQD_InvCallback_SpawnAfterDelete();
+		replaceCb.request = operation;
+		replaceCb.component = this;
+		replaceCb.storageManager = storageManager;
+		replaceCb.slotStorage = storage;
+		replaceCb.batch = batch;
+		
+		storageManager.TryDeleteItem(attachedEntity, replaceCb);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Aggregated response with one result per operation
+	void SendStorageBatchResponse(PQD_StorageBatch batch)
+	{
+		if (batch.loadoutApply)
+		{
+			FinishApplyPlayerLoadoutInPlace(batch);
+			GetGame().GetCallqueue().Call(ReleaseStorageBatch, batch);
+			return;
+		}
+		
+		int total = batch.results.Count();
+		int succeeded = batch.CountSucceeded();
+		
+		string message = string.Format("%1/%2 changes applied", succeeded, total);
+		if (batch.totalCost > 0)
+			message = string.Format("%1 (-%2 supply)", message, batch.totalCost);
+		if (batch.totalRefund > 0)
+			message = string.Format("%1 (+%2 refund)", message, batch.totalRefund);
+		
+		PQD_NetworkResponse response = new PQD_NetworkResponse();
+		response.request = batch.request;
+		response.success = succeeded == total;
 		response.message = message;
+		response.operationResults = batch.results;
 		
-		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
-		saveContext.WriteValue("", response);
+		Print(string.Format("[PQD] Response: %1, success: %2, message: %3", batch.request.Repr(), response.success, message), LogLevel.DEBUG);
+		
+		if (ClientHasPrefabDictionary())
+			batch.request.CompactPrefabs();
 		
-		string responseString = saveContext.ExportToString();
+		SendResponse(response);
 		
-		Rpc(RpcDo_SendActionResponse, responseString);
+		// Batch may still be on the call stack (inventory callback), release it next frame
+		GetGame().GetCallqueue().Call(ReleaseStorageBatch, batch);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void ReleaseStorageBatch(PQD_StorageBatch batch)
+	{
+		m_aActiveStorageBatches.RemoveItem(batch);
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -739,6 +1611,13 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		loadContext.ImportFromString(requestJson);
 		loadContext.ReadValue("", request);
 		
+		if (!m_RequestThrottle.TryAdmit(request))
+		{
+			m_RequestThrottle.CountDropped();
+			SendActionResponse(request, false, "Too many requests, slow down");
+			return;
+		}
+		
 		if (!m_LoadoutStorageComponent)
 		{
 			SendActionResponse(request, false, "Loadout manager component missing from game mode");
@@ -826,6 +1705,14 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 				}
 				Action_ApplyPlayerLoadout(arsenal, arsenalManager, request, identity, factionKey, playerId, true);
 				break;
+			case PQD_ActionType.SET_AI_LOADOUT_ADMIN:
+				if (!SCR_Global.IsAdmin(m_PC.GetPlayerId()))
+				{
+					SendActionResponse(request, false, "Not admin");
+					return;
+				}
+				Action_BulkApplyAdminLoadout(request, factionKey, playerId);
+				break;
 			case PQD_ActionType.CLEAR_LOADOUT_ADMIN:
 				if (!SCR_Global.IsAdmin(m_PC.GetPlayerId()))
 				{
@@ -915,61 +1802,84 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		Print(string.Format("[PQD] Notifying client about slot update: player=%1, faction=%2, slot=%3, valid=%4", 
 			playerId, factionKey, slotIndex, isValid), LogLevel.DEBUG);
 		
-		if (isValid && m_LoadoutStorageComponent)
+		PQD_LoadoutDataTransfer transfer = new PQD_LoadoutDataTransfer();
+		transfer.factionKey = factionKey;
+		transfer.slotIndex = slotIndex;
+		
+		// New content version of the faction, so the client patches its copy instead of fetching it again
+		int version;
+		if (m_LoadoutStorageComponent)
 		{
-			// If slot is now valid, also send the loadout data for preview
-			string prefab, loadoutData, requiredRank;
-			float cost;
+			array<int> validSlots = {};
+			array<ref PQD_LoadoutDataTransfer> factionTransfers = {};
+			CollectFactionTransfers(playerId, factionKey, validSlots, factionTransfers);
+			version = GetLoadoutTransfersVersion(factionTransfers);
 			
-			if (m_LoadoutStorageComponent.GetPlayerLoadoutData(playerId, factionKey, slotIndex, prefab, loadoutData, cost, false, requiredRank))
+			// If slot is now valid, also send the loadout data for preview
+			foreach (PQD_LoadoutDataTransfer factionTransfer : factionTransfers)
 			{
-				// Send slot update with data
-				Rpc(RpcDo_UpdateSingleSlotWithDataOwner, factionKey, slotIndex, isValid, prefab, loadoutData, cost, requiredRank);
-				return;
+				if (!isValid || factionTransfer.slotIndex != slotIndex)
+					continue;
+				
+				transfer = factionTransfer;
+				if (ClientHasPrefabDictionary())
+					transfer.CompactPrefabs();
+				
+				if (ClientHasCapability(PQD_ClientCapability.LOADOUT_COMPRESSION))
+					transfer.loadoutData = PQD_LoadoutCompression.Compress(transfer.loadoutData);
 			}
 		}
 		
-		// Fallback: just send validity update without data
-		Rpc(RpcDo_UpdateSingleSlotOwner, factionKey, slotIndex, isValid);
+		// Version the client holds if it got every earlier change, it must match for the patch to apply
+		// Otherwise the client fetches the whole faction and reports the version it holds
+		int previousVersion;
+		if (m_aConfirmedFactions.Contains(factionKey))
+		{
+			previousVersion = m_mClientFactionVersions.Get(factionKey);
+			m_mClientFactionVersions.Set(factionKey, version);
+		}
+		
+		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
+		saveContext.WriteValue("slot", transfer);
+		saveContext.WriteValue("previousVersion", previousVersion);
+		saveContext.WriteValue("version", version);
+		SendPayload(PQD_PayloadKind.SLOT_UPDATE, saveContext.ExportToString());
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
-	void RpcDo_UpdateSingleSlotWithDataOwner(string factionKey, int slotIndex, bool isValid, string prefab, string loadoutData, float cost, string requiredRank)
+	//! Client side: a slot was saved or cleared, patch the cached faction with it
+	protected void ApplySlotUpdate(string json)
 	{
-		Print(string.Format("[PQD] Client received slot update with data: faction=%1, slot=%2, valid=%3, data size=%4", 
-			factionKey, slotIndex, isValid, loadoutData.Length()), LogLevel.NORMAL);
-		
-		if (isValid)
+		SCR_JsonLoadContext loadContext = new SCR_JsonLoadContext();
+		if (!loadContext.ImportFromString(json))
 		{
-			// Update the client cache with the new data
-			PQD_ClientLoadoutCache.SetLoadoutData(factionKey, slotIndex, prefab, loadoutData, cost, requiredRank);
-			
-			// Also update the valid slots array
-			// Request full refresh to update the valid slots properly
-			Rpc(RpcAsk_ValidSlotsPlease);
+			Print("[PQD] Failed to parse slot update JSON", LogLevel.WARNING);
+			return;
 		}
-		else
+		
+		PQD_LoadoutDataTransfer transfer = new PQD_LoadoutDataTransfer();
+		if (!loadContext.ReadValue("slot", transfer))
+			return;
+		
+		int previousVersion, version;
+		loadContext.ReadValue("previousVersion", previousVersion);
+		loadContext.ReadValue("version", version);
+		
+		bool isValid = !transfer.loadoutData.IsEmpty();
+		if (isValid)
 		{
-			// Clear the data for this slot
-			PQD_ClientLoadoutCache.ClearLoadoutData(factionKey, slotIndex);
-			Rpc(RpcAsk_ValidSlotsPlease);
+			transfer.ExpandPrefabs();
+			PQD_ClientLoadoutCache.SetLoadoutData(transfer.factionKey, transfer.slotIndex, transfer.prefab, transfer.loadoutData, transfer.cost, transfer.requiredRank);
 		}
-	}
-	
-	//------------------------------------------------------------------------------------------------
-	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
-	void RpcDo_UpdateSingleSlotOwner(string factionKey, int slotIndex, bool isValid)
-	{
-		Print(string.Format("[PQD] Client received slot update: faction=%1, slot=%2, valid=%3", factionKey, slotIndex, isValid), LogLevel.DEBUG);
 		
-		// Update the client cache
-		// First, check if we have data for this faction
-		// We need to get the current slots and modify them
+		Print(string.Format("[PQD] Client received slot update: faction=%1, slot=%2, data size=%3", 
+			transfer.factionKey, transfer.slotIndex, transfer.loadoutData.Length()), LogLevel.DEBUG);
+		
+		// Only a cache that missed an earlier change needs the whole faction again
+		if (!PQD_ClientLoadoutCache.ApplySlotChange(transfer.factionKey, transfer.slotIndex, isValid, previousVersion, version))
+			RequestFactionSlots(transfer.factionKey, PQD_ClientLoadoutCache.GetFactionVersion(transfer.factionKey));
 		
-		// For simplicity, request a full refresh of valid slots
-		// This ensures consistency with the server
-		Rpc(RpcAsk_ValidSlotsPlease);
+		PQD_ClientLoadoutCache.ScheduleSaveToProfile();
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -990,10 +1900,39 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 			return;
 		}
 		
-		EntitySpawnParams params = new EntitySpawnParams();
-		params.TransformMode = ETransformMode.WORLD;
-		previousEntity.GetWorldTransform(params.Transform);
-		params.Transform[3] = params.Transform[3] + (vector.Up * 0.05);
+		if (prefab.IsEmpty())
+		{
+			SendActionResponse(request, false, "Invalid character prefab");
+			return;
+		}
+		
+		// Same base character - only the slots that differ are changed
+		ResourceName currentPrefab;
+		PQD_GameModeComponent gameModeComponent = PQD_GameModeComponent.GetInstance();
+		bool inPlace = gameModeComponent && gameModeComponent.IsInPlaceLoadoutApplyEnabled();
+		if (inPlace && PQD_Helpers.GetResourceNameFromEntity(previousEntity, currentPrefab) && currentPrefab == prefab)
+		{
+			if (Action_ApplyPlayerLoadoutInPlace(arsenal, request, previousEntity, prefab, loadoutData, playerId, cost))
+				return;
+		}
+		
+		Action_ApplyPlayerLoadoutReplace(arsenal, request, previousEntity, prefab, loadoutData, playerId, cost);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Apply an admin loadout to every character of the requested scope, the response is sent once all are done
+	void Action_BulkApplyAdminLoadout(PQD_LoadoutRequest request, string factionKey, int playerId)
+	{
+		string loadoutData;
+		string prefab;
+		string requiredRank;
+		float cost;
+		
+		if (!m_LoadoutStorageComponent.GetPlayerLoadoutData(playerId, factionKey, request.loadoutSlotId, prefab, loadoutData, cost, true, requiredRank))
+		{
+			SendActionResponse(request, false, "Failed to load loadout");
+			return;
+		}
 		
 		if (prefab.IsEmpty())
 		{
@@ -1001,6 +1940,144 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 			return;
 		}
 		
+		PQD_ParsedLoadout parsed = PQD_ParsedLoadout.Get(loadoutData);
+		if (!parsed)
+		{
+			SendActionResponse(request, false, "Failed to parse loadout");
+			return;
+		}
+		
+		// A kit saved for one faction is not handed to every player of another
+		// Other scopes are checked per target as the queue reaches them
+		if (request.bulkScope == PQD_BulkApplyScope.FACTION)
+		{
+			string kitFactionKey = parsed.factionKey;
+			string targetFactionKey = PQD_BulkLoadoutApplyQueue.GetTargetFactionKey(request, factionKey);
+			if (!kitFactionKey.IsEmpty() && kitFactionKey != targetFactionKey)
+			{
+				SendActionResponse(request, false, string.Format("Loadout belongs to faction %1, not %2", kitFactionKey, targetFactionKey));
+				return;
+			}
+		}
+		
+		PQD_BulkApplyJob job = new PQD_BulkApplyJob();
+		PQD_BulkLoadoutApplyQueue.CollectTargets(request, playerId, factionKey, job.targets);
+		if (job.targets.IsEmpty())
+		{
+			SendActionResponse(request, false, "No characters to apply the loadout to");
+			return;
+		}
+		
+		// Loaded while the first targets wait for their turn
+		PQD_PrefabPreloader.PreloadLoadout(prefab, loadoutData);
+		
+		job.requester = this;
+		job.request = request;
+		job.prefab = prefab;
+		job.loadoutData = loadoutData;
+		job.factionKey = factionKey;
+		job.kitFactionKey = parsed.factionKey;
+		
+		PQD_BulkLoadoutApplyQueue.Enqueue(job);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Diff the saved loadout against the character and run the differences as one storage batch
+	//! Returns false if the loadout cannot be applied in place
+	protected bool Action_ApplyPlayerLoadoutInPlace(SCR_ArsenalComponent arsenal, PQD_LoadoutRequest request, IEntity character, ResourceName prefab, string loadoutData, int playerId, float cost)
+	{
+		RplId arsenalEntityRplId = Replication.FindId(arsenal.GetOwner());
+		
+		array<ref PQD_StorageRequest> operations = {};
+		if (!PQD_LoadoutSlotDiff.BuildOperations(character, loadoutData, arsenalEntityRplId, operations))
+		{
+			Print(string.Format("[PQD] Loadout for player %1 cannot be applied in place, replacing character", playerId), LogLevel.DEBUG);
+			return false;
+		}
+		
+		if (operations.IsEmpty())
+		{
+			SendActionResponse(request, true, "Loadout already equipped");
+			return true;
+		}
+		
+		SCR_InventoryStorageManagerComponent storageManager = SCR_InventoryStorageManagerComponent.Cast(character.FindComponent(SCR_InventoryStorageManagerComponent));
+		if (!storageManager)
+			return false;
+		
+		PQD_StorageBatchRequest batchRequest = new PQD_StorageBatchRequest();
+		batchRequest.arsenalEntityRplId = arsenalEntityRplId;
+		batchRequest.operations = operations;
+		
+		PQD_InPlaceLoadoutApply loadoutApply = new PQD_InPlaceLoadoutApply();
+		loadoutApply.request = request;
+		loadoutApply.arsenal = arsenal;
+		loadoutApply.character = character;
+		loadoutApply.prefab = prefab;
+		loadoutApply.loadoutData = loadoutData;
+		loadoutApply.playerId = playerId;
+		loadoutApply.cost = cost;
+		
+		// Same rules as a full apply: no per-item charge or refund, so a fallback replacement after a
+		// partial batch settles the loadout cost exactly once
+		PQD_StorageBatch batch = new PQD_StorageBatch(this, batchRequest);
+		batch.storageManager = storageManager;
+		batch.arsenal = PQD_ArsenalContext.Get(arsenalEntityRplId);
+		batch.refundRemovedItems = false;
+		batch.loadoutApply = loadoutApply;
+		
+		Print(string.Format("[PQD] Applying loadout in place for player %1: %2 slot changes", playerId, operations.Count()), LogLevel.DEBUG);
+		
+		m_aActiveStorageBatches.Insert(batch);
+		batch.ProcessNext();
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Called when the in-place batch is done, a partial result is completed by a full replacement
+	protected void FinishApplyPlayerLoadoutInPlace(PQD_StorageBatch batch)
+	{
+		PQD_InPlaceLoadoutApply loadoutApply = batch.loadoutApply;
+		int total = batch.results.Count();
+		int succeeded = batch.CountSucceeded();
+		
+		if (succeeded == total)
+		{
+			SendActionResponse(loadoutApply.request, true, string.Format("Loadout applied (%1 changes)", total));
+			return;
+		}
+		
+		Print(string.Format("[PQD] In-place loadout apply failed (%1/%2): %3", succeeded, total, batch.GetFirstError()), LogLevel.WARNING);
+		
+		if (!loadoutApply.character || !loadoutApply.arsenal)
+		{
+			SendActionResponse(loadoutApply.request, false, "Failed to apply loadout");
+			return;
+		}
+		
+		// The batch never charges or refunds items, anything it did would be counted again by the replacement
+		if (batch.totalCost != 0 || batch.totalRefund != 0)
+		{
+			Print(string.Format("[PQD] In-place loadout batch moved supplies (-%1 / +%2), not replacing the character", batch.totalCost, batch.totalRefund), LogLevel.ERROR);
+			SendActionResponse(loadoutApply.request, false, "Failed to apply loadout");
+			return;
+		}
+		
+		Action_ApplyPlayerLoadoutReplace(loadoutApply.arsenal, loadoutApply.request, loadoutApply.character, loadoutApply.prefab, loadoutApply.loadoutData, loadoutApply.playerId, loadoutApply.cost);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Spawn a new character with the loadout and hand it over to the player
+	protected void Action_ApplyPlayerLoadoutReplace(SCR_ArsenalComponent arsenal, PQD_LoadoutRequest request, IEntity previousEntity, ResourceName prefab, string loadoutData, int playerId, float cost)
+	{
+		// Item prefabs load while the new character becomes ready
+		PQD_PrefabPreloader.PreloadLoadout(string.Empty, loadoutData);
+		
+		EntitySpawnParams params = new EntitySpawnParams();
+		params.TransformMode = ETransformMode.WORLD;
+		previousEntity.GetWorldTransform(params.Transform);
+		params.Transform[3] = params.Transform[3] + (vector.Up * 0.05);
+		
 		Resource loaded = Resource.Load(prefab);
 		if (!loaded)
 		{
@@ -1008,6 +2085,7 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 			return;
 		}
 		
+		int spawnTime = System.GetTickCount();
 		IEntity entity = GameEntity.Cast(GetGame().SpawnEntityPrefabEx(prefab, false, GetGame().GetWorld(), params));
 		if (!entity)
 		{
@@ -1033,11 +2111,38 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		
 		controller.TryEquipRightHandItem(null, EEquipItemType.EEquipTypeUnarmedDeliberate, true);
 		
-		GetGame().GetCallqueue().CallLater(Action_ApplyPlayerLoadout_StepTwo, 200, false, arsenal.GetOwner(), loadoutData, controller, entity, previousEntity, request, playerId, cost);
+		// Second step runs as soon as the new character is replicated and its inventory exists
+		PQD_ApplyLoadoutReadinessTask task = new PQD_ApplyLoadoutReadinessTask();
+		task.entity = entity;
+		task.conditions = PQD_ReadinessCondition.ENTITY_REPLICATED | PQD_ReadinessCondition.CONTROLLER_READY | PQD_ReadinessCondition.INVENTORY_READY;
+		task.spawnTime = spawnTime;
+		task.component = this;
+		task.arsenal = arsenal.GetOwner();
+		task.loadoutData = loadoutData;
+		task.controller = controller;
+		task.previousEntity = previousEntity;
+		task.request = request;
+		task.playerId = playerId;
+		task.cost = cost;
+		
+		PQD_ReadinessScheduler.Enqueue(task);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Drop a spawned replacement character that never became ready
+	void Action_ApplyPlayerLoadout_Cancel(IEntity arsenal, IEntity newEntity, PQD_LoadoutRequest request, float refundCost, string reason)
+	{
+		Print(string.Format("[PQD] Loadout apply cancelled: %1", reason), LogLevel.ERROR);
+		
+		if (newEntity)
+			RplComponent.DeleteRplEntity(newEntity, false);
+		
+		TryRefundFixedCost(arsenal, refundCost);
+		SendActionResponse(request, false, "Failed to apply loadout");
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	void Action_ApplyPlayerLoadout_StepTwo(IEntity arsenal, string loadoutData, CharacterControllerComponent controller, IEntity newEntity, IEntity previousEntity, PQD_LoadoutRequest request, int playerId, float refundCost)
+	bool Action_ApplyPlayerLoadout_StepTwo(IEntity arsenal, string loadoutData, CharacterControllerComponent controller, IEntity newEntity, IEntity previousEntity, PQD_LoadoutRequest request, int playerId, float refundCost)
 	{
 		string identity;
 		PQD_Helpers.GetPlayerIdentityId(playerId, identity);
@@ -1045,26 +2150,21 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		
 		if (!newEntity || !previousEntity || !controller)
 		{
-			Print("[PQD] Entity disappeared before loadout could be applied", LogLevel.ERROR);
-			TryRefundFixedCost(arsenal, refundCost);
-			return;
+			Action_ApplyPlayerLoadout_Cancel(arsenal, newEntity, request, refundCost, "entity disappeared before loadout could be applied");
+			return false;
 		}
 
 		GameEntity entityGame = GameEntity.Cast(newEntity);
-
-		SCR_JsonLoadContext ctx = new SCR_JsonLoadContext();
-		ctx.ImportFromString(loadoutData);
 		
-		// CRITICAL: Ensure ARSENALLOADOUT_COMPONENTS_TO_CHECK is initialized
-		// Without this, inventory items inside backpacks/vests won't be applied!
-		if (!SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK || SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK.IsEmpty())
+		PQD_PrefabPreloader.ReportApply(string.Empty, loadoutData);
+		
+		// The player keeps the previous character if the kit cannot be applied
+		if (!entityGame || !PQD_PlayerFactionLoadoutStorage.ApplyToCharacter(entityGame, loadoutData))
 		{
-			Print("[PQD] Action_ApplyPlayerLoadout_StepTwo: Initializing ARSENALLOADOUT_COMPONENTS_TO_CHECK", LogLevel.WARNING);
-			SCR_ArsenalManagerComponent.GetArsenalLoadoutComponentsToCheck(SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK);
+			Action_ApplyPlayerLoadout_Cancel(arsenal, newEntity, request, refundCost, "loadout could not be applied to the new character");
+			return false;
 		}
 		
-		SCR_PlayerArsenalLoadout.ApplyLoadoutString(entityGame, ctx);
-		
 		SCR_ECharacterRank rank = SCR_CharacterRankComponent.GetCharacterRank(previousEntity);
 		if (rank != SCR_ECharacterRank.INVALID)
 		{
@@ -1079,6 +2179,7 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		RplComponent.DeleteRplEntity(previousEntity, false);
 		
 		AfterLoadoutAppliedSuccessfully(playerId, newEntity);
+		return true;
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -1093,8 +2194,7 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 	}
 	
 	//------------------------------------------------------------------------------------------------
-	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
-	void RpcDo_SendActionResponse(string responseJson)
+	protected void ApplyActionResponse(string responseJson)
 	{
 		Print(string.Format("[PQD] Processing response: %1", responseJson), LogLevel.DEBUG);
 		
@@ -1103,6 +2203,18 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 		
 		PQD_NetworkResponse response = new PQD_NetworkResponse();
 		loadContext.ReadValue("", response);
+		
+		if (!response.request)
+			return;
+		
+		// Responses are matched by sequence id, not by action type
+		if (response.request.sequenceId > 0)
+		{
+			if (!m_mInFlightRequests.Contains(response.request.sequenceId))
+				Print(string.Format("[PQD] Response for unknown request #%1", response.request.sequenceId), LogLevel.WARNING);
+			m_mInFlightRequests.Remove(response.request.sequenceId);
+			m_mInFlightSentAt.Remove(response.request.sequenceId);
+		}
 
 		switch (response.request.actionType)
 		{
@@ -1113,11 +2225,21 @@ sealed class PQD_PlayerControllerComponent : ScriptComponent
 			case PQD_ActionType.CHANGE_SOUND_IDENTITY:
 				PQD_StorageRequest storageRequest;
 				loadContext.ReadValue("request", storageRequest);
+				if (storageRequest)
+					storageRequest.ExpandPrefab();
 				m_OnResponse_Storage.Invoke(response, storageRequest);
 				break;
+			case PQD_ActionType.STORAGE_BATCH:
+				PQD_StorageBatchRequest batchRequest;
+				loadContext.ReadValue("request", batchRequest);
+				if (batchRequest)
+					batchRequest.ExpandPrefabs();
+				m_OnResponse_StorageBatch.Invoke(response, batchRequest);
+				break;
 			case PQD_ActionType.GET_ADMIN_LOADOUTS:
 			case PQD_ActionType.SAVE_LOADOUT_ADMIN:
 			case PQD_ActionType.APPLY_LOADOUT_ADMIN:
+			case PQD_ActionType.SET_AI_LOADOUT_ADMIN:
 			case PQD_ActionType.CLEAR_LOADOUT_ADMIN:
 			case PQD_ActionType.GET_LOADOUTS:
 			case PQD_ActionType.SAVE_LOADOUT:
@@ -1139,17 +2261,28 @@ class PQD_InvCallback : ScriptedInventoryOperationCallback
 	string messageOk;
 	string messageFailed;
 	PQD_PlayerControllerComponent component;
+	PQD_StorageBatch batch; // Set when the operation is part of a storage batch
 
 	override void OnComplete()
 	{
-		if (component)
-			component.SendActionResponse(request, true, messageOk);
+		Finish(true, messageOk);
 	}
 	
 	override void OnFailed()
 	{
+		Finish(false, messageFailed);
+	}
+	
+	protected void Finish(bool success, string message)
+	{
+		if (batch)
+		{
+			batch.OnOperationFinished(success, message);
+			return;
+		}
+		
 		if (component)
-			component.SendActionResponse(request, false, messageFailed);
+			component.SendActionResponse(request, success, message);
 	}
 }
 
@@ -1191,6 +2324,7 @@ sealed class PQD_InvCallback_SpawnAfterDelete : PQD_InvCallback
 			deleteCb.temporaryEntity = itemEntity;
 			deleteCb.component = component;
 			deleteCb.request = request;
+			deleteCb.batch = batch;
 	
 			storageManager.TryInsertItemInStorage(itemEntity, slotStorage, storageRequest.storageSlotId, deleteCb);
 			return;
@@ -1211,3 +2345,154 @@ sealed class PQD_InvCallback_SpawnAfterDelete : PQD_InvCallback
 		super.OnFailed();
 	}
 }
+
+//------------------------------------------------------------------------------------------------
+//! Second step of an arsenal loadout apply, waiting for the spawned replacement character
+sealed class PQD_ApplyLoadoutReadinessTask : PQD_ReadinessTask
+{
+	PQD_PlayerControllerComponent component;
+	IEntity arsenal;
+	string loadoutData;
+	CharacterControllerComponent controller;
+	IEntity previousEntity;
+	ref PQD_LoadoutRequest request;
+	int playerId;
+	float cost;
+	
+	//------------------------------------------------------------------------------------------------
+	override bool IsValid()
+	{
+		return entity && previousEntity && component;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override void OnReady()
+	{
+		if (component.Action_ApplyPlayerLoadout_StepTwo(arsenal, loadoutData, controller, entity, previousEntity, request, playerId, cost))
+			PQD_ReadinessScheduler.RecordKitted(spawnTime);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override void OnTimeout()
+	{
+		component.Action_ApplyPlayerLoadout_Cancel(arsenal, entity, request, cost, "replacement character not ready");
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override void OnInvalid()
+	{
+		if (component)
+			component.Action_ApplyPlayerLoadout_Cancel(arsenal, entity, request, cost, "character disappeared before loadout could be applied");
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//! Server-side state of a PQD_StorageBatchRequest while its operations run one after another
+sealed class PQD_StorageBatch
+{
+	PQD_PlayerControllerComponent component;
+	ref PQD_StorageBatchRequest request;
+	ref array<ref PQD_StorageOperationResult> results = {};
+	
+	SCR_InventoryStorageManagerComponent storageManager;
+	ref PQD_ArsenalContext arsenal;
+	
+	float totalCost;
+	float totalRefund;
+	bool refundRemovedItems = true;
+	
+	ref PQD_InPlaceLoadoutApply loadoutApply; // Set when the batch applies a saved loadout to the character
+	
+	protected int m_iCurrent = -1;
+	
+	//------------------------------------------------------------------------------------------------
+	void PQD_StorageBatch(PQD_PlayerControllerComponent _component, PQD_StorageBatchRequest _request)
+	{
+		component = _component;
+		request = _request;
+		
+		// null = not processed yet
+		for (int i = 0, count = request.operations.Count(); i < count; i++)
+		{
+			results.Insert(null);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsPending(int index)
+	{
+		return !results[index];
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void SetResult(int index, bool success, string message)
+	{
+		PQD_StorageOperationResult result = new PQD_StorageOperationResult();
+		result.success = success;
+		result.message = message;
+		results.Set(index, result);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void FailPending(string message)
+	{
+		foreach (int i, PQD_StorageOperationResult result : results)
+		{
+			if (!result)
+				SetResult(i, false, message);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	string GetFirstError()
+	{
+		foreach (PQD_StorageOperationResult result : results)
+		{
+			if (result && !result.success)
+				return result.message;
+		}
+		
+		return string.Empty;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int CountSucceeded()
+	{
+		int succeeded;
+		foreach (PQD_StorageOperationResult result : results)
+		{
+			if (result && result.success)
+				succeeded++;
+		}
+		
+		return succeeded;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void ProcessNext()
+	{
+		if (!component)
+			return;
+		
+		m_iCurrent++;
+		while (m_iCurrent < results.Count() && !IsPending(m_iCurrent))
+		{
+			m_iCurrent++;
+		}
+		
+		if (m_iCurrent >= results.Count())
+		{
+			component.SendStorageBatchResponse(this);
+			return;
+		}
+		
+		component.ExecuteStorageBatchOperation(this, request.operations[m_iCurrent]);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void OnOperationFinished(bool success, string message)
+	{
+		SetResult(m_iCurrent, success, message);
+		ProcessNext();
+	}
+}
@@ -0,0 +1,272 @@
+// PQD Loadout Editor - Prefab Dictionary
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Per-session mapping of arsenal-known prefabs to compact integer IDs
+// Note: IDs are only valid for the current session - never persist them to disk
+
+//------------------------------------------------------------------------------------------------
+//! Payload sent to clients when the dictionary is replicated
+class PQD_PrefabDictionaryTransfer
+{
+	int version;
+	ref array<ResourceName> prefabs = {};
+}
+
+//------------------------------------------------------------------------------------------------
+//! Static prefab <-> ID dictionary
+//! Server builds it from the faction entity catalogs, clients receive it once per session
+class PQD_PrefabDictionary
+{
+	// Marker used to reference a dictionary entry inside serialized loadout data
+	static const string ID_MARKER = "\"@";
+
+	// Index = prefab ID
+	protected static ref array<ResourceName> s_aPrefabs = {};
+
+	// Map: prefab -> prefab ID
+	protected static ref map<ResourceName, int> s_mPrefabIds = new map<ResourceName, int>();
+
+	// 0 = not built / not received
+	protected static int s_iVersion = 0;
+
+	//------------------------------------------------------------------------------------------------
+	static int GetVersion()
+	{
+		return s_iVersion;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static bool IsReady()
+	{
+		return s_iVersion != 0;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	static int Count()
+	{
+		return s_aPrefabs.Count();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get the ID of a prefab, -1 if the prefab is not in the dictionary
+	static int GetPrefabId(ResourceName prefab)
+	{
+		if (prefab.IsEmpty())
+			return -1;
+
+		int id;
+		if (!s_mPrefabIds.Find(prefab, id))
+			return -1;
+
+		return id;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Get the prefab for an ID, empty if the ID is unknown
+	static ResourceName GetPrefab(int prefabId)
+	{
+		if (!s_aPrefabs.IsIndexValid(prefabId))
+			return "";
+
+		return s_aPrefabs[prefabId];
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static void AddPrefab(ResourceName prefab)
+	{
+		if (prefab.IsEmpty() || s_mPrefabIds.Contains(prefab))
+			return;
+
+		s_mPrefabIds.Insert(prefab, s_aPrefabs.Insert(prefab));
+		s_iVersion = s_iVersion * 31 + prefab.Hash();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	protected static void AddCatalog(SCR_EntityCatalog catalog)
+	{
+		if (!catalog)
+			return;
+
+		array<SCR_EntityCatalogEntry> entries = {};
+		catalog.GetEntityList(entries);
+
+		foreach (SCR_EntityCatalogEntry entry : entries)
+		{
+			if (entry)
+				AddPrefab(entry.GetPrefab());
+		}
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Build the dictionary from the item and character catalogs (server only, once per session)
+	static void BuildFromCatalogs()
+	{
+		if (IsReady())
+			return;
+
+		s_aPrefabs.Clear();
+		s_mPrefabIds.Clear();
+		s_iVersion = 17;
+
+		SCR_EntityCatalogManagerComponent entityCatalogManager = SCR_EntityCatalogManagerComponent.GetInstance();
+		if (entityCatalogManager)
+		{
+			AddCatalog(entityCatalogManager.GetEntityCatalogOfType(EEntityCatalogType.ITEM));
+			AddCatalog(entityCatalogManager.GetEntityCatalogOfType(EEntityCatalogType.CHARACTER));
+		}
+
+		FactionManager factionManager = GetGame().GetFactionManager();
+		if (factionManager)
+		{
+			array<Faction> factions = {};
+			factionManager.GetFactionsList(factions);
+
+			foreach (Faction faction : factions)
+			{
+				SCR_Faction scrFaction = SCR_Faction.Cast(faction);
+				if (!scrFaction)
+					continue;
+
+				AddCatalog(scrFaction.GetFactionEntityCatalogOfType(EEntityCatalogType.ITEM));
+				AddCatalog(scrFaction.GetFactionEntityCatalogOfType(EEntityCatalogType.CHARACTER));
+			}
+		}
+
+		// Never leave version at 0 once built, so clients can tell "built but empty" from "missing"
+		if (s_iVersion == 0)
+			s_iVersion = 1;
+
+		Print(string.Format("[PQD] PrefabDictionary: Built %1 entries (version %2)", s_aPrefabs.Count(), s_iVersion), LogLevel.NORMAL);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Serialize the dictionary for replication
+	static string ExportToString()
+	{
+		PQD_PrefabDictionaryTransfer transfer = new PQD_PrefabDictionaryTransfer();
+		transfer.version = s_iVersion;
+		transfer.prefabs.Copy(s_aPrefabs);
+
+		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
+		saveContext.WriteValue("", transfer);
+		return saveContext.ExportToString();
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Replace the dictionary with the one received from the server (client only)
+	static bool ImportFromString(string json)
+	{
+		SCR_JsonLoadContext loadContext = new SCR_JsonLoadContext();
+		if (!loadContext.ImportFromString(json))
+			return false;
+
+		PQD_PrefabDictionaryTransfer transfer = new PQD_PrefabDictionaryTransfer();
+		if (!loadContext.ReadValue("", transfer))
+			return false;
+
+		s_aPrefabs.Clear();
+		s_mPrefabIds.Clear();
+
+		foreach (int id, ResourceName prefab : transfer.prefabs)
+		{
+			s_aPrefabs.Insert(prefab);
+			s_mPrefabIds.Set(prefab, id);
+		}
+
+		s_iVersion = transfer.version;
+
+		Print(string.Format("[PQD] PrefabDictionary: Received %1 entries (version %2)", s_aPrefabs.Count(), s_iVersion), LogLevel.NORMAL);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Replace every quoted dictionary prefab inside serialized loadout data with "@<id>"
+	static string EncodeResourceNames(string data)
+	{
+		if (!IsReady() || data.IsEmpty())
+			return data;
+
+		string result;
+		int copyFrom = 0;
+		int start = data.IndexOf("\"{");
+
+		while (start != -1)
+		{
+			int end = data.IndexOfFrom(start + 1, "\"");
+			if (end == -1)
+				break;
+
+			int id = GetPrefabId(data.Substring(start + 1, end - start - 1));
+			if (id != -1)
+			{
+				result += data.Substring(copyFrom, start - copyFrom);
+				result += ID_MARKER + id.ToString() + "\"";
+				copyFrom = end + 1;
+			}
+
+			start = data.IndexOfFrom(end + 1, "\"{");
+		}
+
+		if (copyFrom == 0)
+			return data;
+
+		return result + data.Substring(copyFrom, data.Length() - copyFrom);
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Only what EncodeResourceNames writes after the marker, a non-empty run of digits
+	protected static bool IsIdToken(string token)
+	{
+		int length = token.Length();
+		if (length == 0)
+			return false;
+
+		for (int i = 0; i < length; i++)
+		{
+			int c = token.ToAscii(i);
+			if (c < 48 || c > 57)
+				return false;
+		}
+
+		return true;
+	}
+
+	//------------------------------------------------------------------------------------------------
+	//! Inverse of EncodeResourceNames, only call it on data that was encoded
+	static string DecodeResourceNames(string data)
+	{
+		if (data.IsEmpty())
+			return data;
+
+		string result;
+		int copyFrom = 0;
+		int start = data.IndexOf(ID_MARKER);
+
+		while (start != -1)
+		{
+			int end = data.IndexOfFrom(start + 2, "\"");
+			if (end == -1)
+				break;
+
+			// Any other "@..." string value is left alone, ToInt() would turn it into ID 0
+			ResourceName prefab;
+			string token = data.Substring(start + 2, end - start - 2);
+			if (IsIdToken(token))
+				prefab = GetPrefab(token.ToInt());
+			
+			if (!prefab.IsEmpty())
+			{
+				result += data.Substring(copyFrom, start - copyFrom);
+				result += "\"" + prefab + "\"";
+				copyFrom = end + 1;
+			}
+
+			start = data.IndexOfFrom(end + 1, ID_MARKER);
+		}
+
+		if (copyFrom == 0)
+			return data;
+
+		return result + data.Substring(copyFrom, data.Length() - copyFrom);
+	}
+}
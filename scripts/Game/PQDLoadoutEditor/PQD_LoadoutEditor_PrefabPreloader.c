@@ -0,0 +1,178 @@
+// PQD Loadout Editor - Prefab Preloader
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Loads the prefabs of a selected kit a few per frame before it is spawned or previewed
+
+//------------------------------------------------------------------------------------------------
+//! Static preload queue, keeps loaded resources referenced until they have not been used for a while
+class PQD_PrefabPreloader
+{
+	static const int LOADS_PER_FRAME = 4;
+	static const int FRAME_BUDGET_MS = 2;
+	
+	// Unused resources are released after this long
+	static const int RETENTION_MS = 120000;
+	
+	protected static ref map<ResourceName, ref Resource> s_mLoaded = new map<ResourceName, ref Resource>();
+	protected static ref map<ResourceName, int> s_mLastUse = new map<ResourceName, int>();
+	protected static ref array<ResourceName> s_aQueue = {};
+	protected static bool s_bTicking;
+	
+	// Metrics
+	protected static int s_iPreloadedCount;
+	protected static int s_iHitCount;
+	protected static int s_iCriticalPathCount;
+	
+	//------------------------------------------------------------------------------------------------
+	//! Queue the character prefab and every item prefab of a serialized loadout
+	static void PreloadLoadout(ResourceName characterPrefab, string loadoutData)
+	{
+		ReleaseUnused();
+		
+		array<ResourceName> prefabs = {};
+		CollectPrefabs(characterPrefab, loadoutData, prefabs);
+		
+		int now = System.GetTickCount();
+		foreach (ResourceName prefab : prefabs)
+		{
+			s_mLastUse.Set(prefab, now);
+			
+			if (s_mLoaded.Contains(prefab) || s_aQueue.Contains(prefab))
+				continue;
+			
+			s_aQueue.Insert(prefab);
+		}
+		
+		if (s_aQueue.IsEmpty() || s_bTicking)
+			return;
+		
+		s_bTicking = true;
+		GetGame().GetCallqueue().CallLater(Tick, 0, true);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Count how many prefabs of a loadout about to be applied were preloaded
+	static void ReportApply(ResourceName characterPrefab, string loadoutData)
+	{
+		array<ResourceName> prefabs = {};
+		CollectPrefabs(characterPrefab, loadoutData, prefabs);
+		
+		int now = System.GetTickCount();
+		int hits;
+		foreach (ResourceName prefab : prefabs)
+		{
+			if (s_mLoaded.Contains(prefab))
+			{
+				hits++;
+				s_mLastUse.Set(prefab, now);
+			}
+		}
+		
+		s_iHitCount += hits;
+		s_iCriticalPathCount += prefabs.Count() - hits;
+		
+		Print(string.Format("[PQD] Preloader: %1/%2 prefabs preloaded ahead of apply (total: %3 ahead, %4 on critical path)",
+			hits, prefabs.Count(), s_iHitCount, s_iCriticalPathCount), LogLevel.DEBUG);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Distinct prefabs referenced by a serialized loadout, at any depth
+	static void CollectPrefabs(ResourceName characterPrefab, string loadoutData, notnull array<ResourceName> prefabs)
+	{
+		if (!characterPrefab.IsEmpty())
+			prefabs.Insert(characterPrefab);
+		
+		PQD_ParsedLoadout parsedLoadout = PQD_ParsedLoadout.Get(loadoutData);
+		if (parsedLoadout)
+			parsedLoadout.CollectPrefabs(prefabs);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void Tick()
+	{
+		int frameStart = System.GetTickCount();
+		int loaded;
+		
+		while (!s_aQueue.IsEmpty())
+		{
+			if (loaded >= LOADS_PER_FRAME || System.GetTickCount() - frameStart >= FRAME_BUDGET_MS)
+				return;
+			
+			ResourceName prefab = s_aQueue[0];
+			s_aQueue.RemoveOrdered(0);
+			
+			Resource resource = Resource.Load(prefab);
+			if (!resource || !resource.IsValid())
+			{
+				Print(string.Format("[PQD] Preloader: Failed to load %1", prefab), LogLevel.WARNING);
+				continue;
+			}
+			
+			s_mLoaded.Set(prefab, resource);
+			s_iPreloadedCount++;
+			loaded++;
+		}
+		
+		GetGame().GetCallqueue().Remove(Tick);
+		s_bTicking = false;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void ReleaseUnused()
+	{
+		int now = System.GetTickCount();
+		
+		array<ResourceName> expired = {};
+		foreach (ResourceName prefab, int lastUse : s_mLastUse)
+		{
+			if (now - lastUse > RETENTION_MS)
+				expired.Insert(prefab);
+		}
+		
+		foreach (ResourceName prefab : expired)
+		{
+			s_mLastUse.Remove(prefab);
+			s_mLoaded.Remove(prefab);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetQueueDepth()
+	{
+		return s_aQueue.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetLoadedCount()
+	{
+		return s_mLoaded.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetPreloadedCount()
+	{
+		return s_iPreloadedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Prefabs already loaded when their loadout was applied
+	static int GetHitCount()
+	{
+		return s_iHitCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Prefabs that still had to be loaded when their loadout was applied
+	static int GetCriticalPathCount()
+	{
+		return s_iCriticalPathCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void ResetMetrics()
+	{
+		s_iPreloadedCount = 0;
+		s_iHitCount = 0;
+		s_iCriticalPathCount = 0;
+	}
+}
@@ -404,6 +404,26 @@ class PQD_PreviewUIComponent : ScriptedWidgetComponent
 			m_bIsDragging = false;
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Show an item that is not spawned yet in place of the previewed entity
+	void SetPreviewedPrefab(ResourceName prefab)
+	{
+		if (prefab.IsEmpty() || !m_wItemPreview || !m_PreviewManager)
+			return;
+		
+		m_PreviewManager.SetPreviewItemFromPrefab(m_wItemPreview, prefab);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Render the previewed entity again, picks up replicated changes and drops a shown prefab
+	void RefreshPreview()
+	{
+		if (!m_CurrentPreviewEntity || !m_wItemPreview || !m_PreviewManager)
+			return;
+		
+		m_PreviewManager.SetPreviewItem(m_wItemPreview, m_CurrentPreviewEntity, m_PreviewAttributes, true);
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	void ClearPreview()
 	{
@@ -0,0 +1,257 @@
+// PQD Loadout Editor - Readiness Scheduler
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Runs loadout apply steps as soon as the spawned character is ready, instead of after fixed delays
+
+//------------------------------------------------------------------------------------------------
+//! One step waiting for a character to become ready
+class PQD_ReadinessTask
+{
+	IEntity entity;
+	int conditions;		// PQD_ReadinessCondition flags
+	int spawnTime;		// Start of the spawn-to-kitted metric
+	int enqueueTime;
+	int readyTime;		// Conditions are not checked before this, retries back off through it
+	int deadline;
+	
+	//------------------------------------------------------------------------------------------------
+	//! False drops the task without running it
+	bool IsValid()
+	{
+		return entity != null;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsReady()
+	{
+		return PQD_ReadinessScheduler.CheckConditions(entity, conditions);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void OnReady();
+	
+	//------------------------------------------------------------------------------------------------
+	void OnTimeout();
+	
+	//------------------------------------------------------------------------------------------------
+	void OnInvalid();
+}
+
+//------------------------------------------------------------------------------------------------
+//! Static list of readiness tasks, polled every frame until ready, invalid or timed out
+class PQD_ReadinessScheduler
+{
+	static const int DEFAULT_TIMEOUT_MS = 5000;
+	
+	protected static ref array<ref PQD_ReadinessTask> s_aTasks = {};
+	protected static bool s_bTicking;
+	
+	// Metrics
+	protected static int s_iReadyCount;
+	protected static int s_iTotalReadyWaitMs;
+	protected static int s_iTimeoutCount;
+	protected static int s_iKittedCount;
+	protected static int s_iTotalKittedMs;
+	protected static int s_iMaxKittedMs;
+	protected static int s_iLastKittedMs;
+	protected static int s_iKittedAtSpawnCount;
+	
+	//------------------------------------------------------------------------------------------------
+	//! \param delayMs Time before the conditions are first checked, the timeout starts after it
+	static void Enqueue(notnull PQD_ReadinessTask task, int timeoutMs = DEFAULT_TIMEOUT_MS, int delayMs = 0)
+	{
+		task.enqueueTime = System.GetTickCount();
+		task.readyTime = task.enqueueTime + delayMs;
+		task.deadline = task.readyTime + timeoutMs;
+		if (task.spawnTime == 0)
+			task.spawnTime = task.enqueueTime;
+		
+		s_aTasks.Insert(task);
+		
+		if (!s_bTicking)
+		{
+			s_bTicking = true;
+			GetGame().GetCallqueue().CallLater(Tick, 0, true);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! True when every requested PQD_ReadinessCondition holds for the entity
+	static bool CheckConditions(IEntity entity, int conditions)
+	{
+		if (!entity)
+			return false;
+		
+		if (conditions & PQD_ReadinessCondition.ENTITY_REPLICATED)
+		{
+			RplComponent rpl = RplComponent.Cast(entity.FindComponent(RplComponent));
+			if (!rpl || !rpl.Id().IsValid())
+				return false;
+		}
+		
+		if (conditions & PQD_ReadinessCondition.CONTROLLER_READY)
+		{
+			CharacterControllerComponent controller = CharacterControllerComponent.Cast(entity.FindComponent(CharacterControllerComponent));
+			if (!controller || controller.IsDead())
+				return false;
+		}
+		
+		if (conditions & PQD_ReadinessCondition.INVENTORY_READY)
+		{
+			SCR_InventoryStorageManagerComponent inventoryManager = SCR_InventoryStorageManagerComponent.Cast(entity.FindComponent(SCR_InventoryStorageManagerComponent));
+			if (!inventoryManager)
+				return false;
+			
+			array<BaseInventoryStorageComponent> storages = {};
+			inventoryManager.GetStorages(storages);
+			if (storages.IsEmpty())
+				return false;
+		}
+		
+		if (conditions & PQD_ReadinessCondition.PLAYER_CONTROLLED)
+		{
+			int playerId = GetGame().GetPlayerManager().GetPlayerIdFromControlledEntity(entity);
+			if (playerId == 0)
+				return false;
+		}
+		
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void Tick()
+	{
+		int now = System.GetTickCount();
+		
+		for (int i = 0; i < s_aTasks.Count(); i++)
+		{
+			PQD_ReadinessTask task = s_aTasks[i];
+			
+			if (!task.IsValid())
+			{
+				s_aTasks.RemoveOrdered(i);
+				i--;
+				task.OnInvalid();
+				continue;
+			}
+			
+			if (now < task.readyTime)
+				continue;
+			
+			if (task.IsReady())
+			{
+				s_aTasks.RemoveOrdered(i);
+				i--;
+				s_iReadyCount++;
+				s_iTotalReadyWaitMs += now - task.readyTime;
+				task.OnReady();
+				continue;
+			}
+			
+			if (now >= task.deadline)
+			{
+				s_aTasks.RemoveOrdered(i);
+				i--;
+				s_iTimeoutCount++;
+				Print(string.Format("[PQD] Readiness: %1 not ready after %2 ms", task.entity, now - task.enqueueTime), LogLevel.WARNING);
+				task.OnTimeout();
+			}
+		}
+		
+		if (!s_aTasks.IsEmpty())
+			return;
+		
+		GetGame().GetCallqueue().Remove(Tick);
+		s_bTicking = false;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Call when a spawned character has its loadout, spawnTime is the task's spawnTime
+	static void RecordKitted(int spawnTime)
+	{
+		int latencyMs = System.GetTickCount() - spawnTime;
+		
+		s_iKittedCount++;
+		s_iTotalKittedMs += latencyMs;
+		s_iMaxKittedMs = Math.Max(s_iMaxKittedMs, latencyMs);
+		s_iLastKittedMs = latencyMs;
+		
+		Print(string.Format("[PQD] Readiness: Character kitted %1 ms after spawn (avg %2 ms, max %3 ms)",
+			latencyMs, GetAverageSpawnToKittedMs(), s_iMaxKittedMs), LogLevel.DEBUG);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Call when the loadout was applied while the character was spawned, nothing waited for readiness
+	//! Kept out of the spawn-to-kitted latency, which would only average in zeros
+	static void RecordKittedAtSpawn()
+	{
+		s_iKittedAtSpawnCount++;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetPendingCount()
+	{
+		return s_aTasks.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetAverageReadyWaitMs()
+	{
+		if (s_iReadyCount == 0)
+			return 0;
+		
+		return s_iTotalReadyWaitMs / s_iReadyCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetTimeoutCount()
+	{
+		return s_iTimeoutCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetKittedCount()
+	{
+		return s_iKittedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetKittedAtSpawnCount()
+	{
+		return s_iKittedAtSpawnCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetAverageSpawnToKittedMs()
+	{
+		if (s_iKittedCount == 0)
+			return 0;
+		
+		return s_iTotalKittedMs / s_iKittedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetMaxSpawnToKittedMs()
+	{
+		return s_iMaxKittedMs;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetLastSpawnToKittedMs()
+	{
+		return s_iLastKittedMs;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void ResetMetrics()
+	{
+		s_iReadyCount = 0;
+		s_iTotalReadyWaitMs = 0;
+		s_iTimeoutCount = 0;
+		s_iKittedCount = 0;
+		s_iTotalKittedMs = 0;
+		s_iMaxKittedMs = 0;
+		s_iLastKittedMs = 0;
+		s_iKittedAtSpawnCount = 0;
+	}
+}
@@ -0,0 +1,227 @@
+// PQD Loadout Editor - Request Throttle
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Per-player token buckets for editor RPCs, with coalescing of superseded slot replacements
+
+//------------------------------------------------------------------------------------------------
+//! Classic token bucket, refilled lazily on access
+sealed class PQD_TokenBucket
+{
+	protected float m_fCapacity;
+	protected float m_fRefillPerSecond;
+	protected float m_fTokens;
+	protected int m_iLastRefillTime;
+	
+	//------------------------------------------------------------------------------------------------
+	void PQD_TokenBucket(float capacity, float refillPerSecond)
+	{
+		m_fCapacity = capacity;
+		m_fRefillPerSecond = refillPerSecond;
+		m_fTokens = capacity;
+		m_iLastRefillTime = System.GetTickCount();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void Refill()
+	{
+		int now = System.GetTickCount();
+		m_fTokens = Math.Min(m_fCapacity, m_fTokens + (now - m_iLastRefillTime) * 0.001 * m_fRefillPerSecond);
+		m_iLastRefillTime = now;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool HasToken()
+	{
+		Refill();
+		return m_fTokens >= 1;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool TryConsume()
+	{
+		if (!HasToken())
+			return false;
+		
+		m_fTokens -= 1;
+		return true;
+	}
+}
+
+//------------------------------------------------------------------------------------------------
+//! Server side rate limiter owned by each PQD_PlayerControllerComponent
+sealed class PQD_RequestThrottle
+{
+	// Maximum number of deferred slot requests per player
+	static const int MAX_DEFERRED_REQUESTS = 8;
+	
+	protected ref map<PQD_RequestClass, ref PQD_TokenBucket> m_mBuckets = new map<PQD_RequestClass, ref PQD_TokenBucket>();
+	
+	// Throttled slot requests in arrival order, only the latest REPLACE_ITEM per slot is kept
+	protected ref array<ref PQD_StorageRequest> m_aDeferred = {};
+	
+	// Counters for this player
+	protected int m_iThrottledCount;
+	protected int m_iDroppedCount;
+	protected int m_iCoalescedCount;
+	
+	// Counters for all players
+	protected static int s_iThrottledCount;
+	protected static int s_iDroppedCount;
+	protected static int s_iCoalescedCount;
+	
+	//------------------------------------------------------------------------------------------------
+	void PQD_RequestThrottle()
+	{
+		// Burst size, sustained requests per second
+		m_mBuckets.Set(PQD_RequestClass.STORAGE, new PQD_TokenBucket(10, 5));
+		m_mBuckets.Set(PQD_RequestClass.STORAGE_BATCH, new PQD_TokenBucket(3, 0.5));
+		m_mBuckets.Set(PQD_RequestClass.LOADOUT_READ, new PQD_TokenBucket(5, 1));
+		m_mBuckets.Set(PQD_RequestClass.LOADOUT_WRITE, new PQD_TokenBucket(3, 0.2));
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static PQD_RequestClass GetRequestClass(PQD_ActionType actionType)
+	{
+		switch (actionType)
+		{
+			case PQD_ActionType.STORAGE_BATCH:
+				return PQD_RequestClass.STORAGE_BATCH;
+			case PQD_ActionType.GET_LOADOUTS:
+			case PQD_ActionType.GET_ADMIN_LOADOUTS:
+				return PQD_RequestClass.LOADOUT_READ;
+			case PQD_ActionType.SAVE_LOADOUT:
+			case PQD_ActionType.CLEAR_LOADOUT:
+			case PQD_ActionType.APPLY_LOADOUT:
+			case PQD_ActionType.SAVE_LOADOUT_ADMIN:
+			case PQD_ActionType.APPLY_LOADOUT_ADMIN:
+			case PQD_ActionType.SET_AI_LOADOUT_ADMIN:
+			case PQD_ActionType.CLEAR_LOADOUT_ADMIN:
+				return PQD_RequestClass.LOADOUT_WRITE;
+		}
+		
+		return PQD_RequestClass.STORAGE;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Consume a token for the request, false if the player is over the limit
+	bool TryAdmit(PQD_NetworkRequest request)
+	{
+		return TryAdmitClass(GetRequestClass(request.actionType));
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Consume a token of a request class, for RPCs that do not carry a PQD_NetworkRequest
+	bool TryAdmitClass(PQD_RequestClass requestClass)
+	{
+		PQD_TokenBucket bucket = m_mBuckets.Get(requestClass);
+		if (!bucket || bucket.TryConsume())
+			return true;
+		
+		m_iThrottledCount++;
+		s_iThrottledCount++;
+		return false;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Record a request that was rejected without being executed
+	void CountDropped()
+	{
+		m_iDroppedCount++;
+		s_iDroppedCount++;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! True for requests that change a storage slot and can wait in the deferred queue
+	static bool IsSlotAction(PQD_ActionType actionType)
+	{
+		return actionType == PQD_ActionType.ADD_ITEM || actionType == PQD_ActionType.REMOVE_ITEM || actionType == PQD_ActionType.REPLACE_ITEM;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Park a slot request until tokens are available, behind every request deferred before it
+	//! A REPLACE_ITEM drops the deferred REPLACE_ITEM of the same slot and goes to the back of the queue
+	//! \param[out] superseded Earlier deferred request for the same slot, now replaced
+	//! \return false if the deferred queue is full
+	bool Defer(PQD_StorageRequest request, out PQD_StorageRequest superseded)
+	{
+		if (request.actionType == PQD_ActionType.REPLACE_ITEM)
+		{
+			foreach (int i, PQD_StorageRequest deferred : m_aDeferred)
+			{
+				if (deferred.actionType != PQD_ActionType.REPLACE_ITEM || deferred.storageRplId != request.storageRplId || deferred.storageSlotId != request.storageSlotId)
+					continue;
+				
+				superseded = deferred;
+				m_aDeferred.RemoveOrdered(i);
+				m_iCoalescedCount++;
+				s_iCoalescedCount++;
+				CountDropped();
+				break;
+			}
+		}
+		
+		if (m_aDeferred.Count() >= MAX_DEFERRED_REQUESTS)
+			return false;
+		
+		m_aDeferred.Insert(request);
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool HasDeferred()
+	{
+		return !m_aDeferred.IsEmpty();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Take the oldest deferred request if a storage token is available
+	PQD_StorageRequest PopDeferred()
+	{
+		if (m_aDeferred.IsEmpty())
+			return null;
+		
+		PQD_TokenBucket bucket = m_mBuckets.Get(PQD_RequestClass.STORAGE);
+		if (bucket && !bucket.TryConsume())
+			return null;
+		
+		PQD_StorageRequest request = m_aDeferred[0];
+		m_aDeferred.RemoveOrdered(0);
+		return request;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetThrottledCount()
+	{
+		return m_iThrottledCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetDroppedCount()
+	{
+		return m_iDroppedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetCoalescedCount()
+	{
+		return m_iCoalescedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetTotalThrottledCount()
+	{
+		return s_iThrottledCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetTotalDroppedCount()
+	{
+		return s_iDroppedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetTotalCoalescedCount()
+	{
+		return s_iCoalescedCount;
+	}
+}
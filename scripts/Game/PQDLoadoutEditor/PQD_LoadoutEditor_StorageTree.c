@@ -0,0 +1,156 @@
+// PQD Loadout Editor - Storage Tree Snapshot
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Storages of the edited character, walked once and kept up to date from inventory events
+
+//------------------------------------------------------------------------------------------------
+//! Storage components of the character and the clothing slots holding containers (backpack, vest...)
+//! Built when bound to a character, then updated from the inventory manager item added/removed
+//! invokers so the menu never walks the character components on refresh
+sealed class PQD_StorageTreeSnapshot
+{
+	protected IEntity m_Character;
+	protected SCR_InventoryStorageManagerComponent m_InventoryManager;
+	protected SCR_CharacterInventoryStorageComponent m_CharacterStorage;
+	
+	protected ref array<BaseInventoryStorageComponent> m_aCharacterStorages = {};
+	protected ref array<InventoryStorageSlot> m_aContainerSlots = {};
+	
+	// Metrics
+	protected int m_iBuildCount;
+	protected int m_iUpdateCount;
+	
+	//------------------------------------------------------------------------------------------------
+	void ~PQD_StorageTreeSnapshot()
+	{
+		Unbind();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Walk the storages of a character and follow its inventory from now on
+	void Bind(IEntity character)
+	{
+		Unbind();
+		
+		m_Character = character;
+		if (!character)
+			return;
+		
+		m_InventoryManager = SCR_InventoryStorageManagerComponent.Cast(character.FindComponent(SCR_InventoryStorageManagerComponent));
+		m_CharacterStorage = SCR_CharacterInventoryStorageComponent.Cast(character.FindComponent(SCR_CharacterInventoryStorageComponent));
+		
+		PQD_Helpers.GetAllEntityStorages(character, m_aCharacterStorages);
+		PQD_Helpers.GetAllCharacterItemStorageSlots(character, m_aContainerSlots);
+		m_iBuildCount++;
+		
+		if (m_InventoryManager)
+		{
+			m_InventoryManager.m_OnItemAddedInvoker.Insert(OnItemAdded);
+			m_InventoryManager.m_OnItemRemovedInvoker.Insert(OnItemRemoved);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	void Unbind()
+	{
+		if (m_InventoryManager)
+		{
+			m_InventoryManager.m_OnItemAddedInvoker.Remove(OnItemAdded);
+			m_InventoryManager.m_OnItemRemovedInvoker.Remove(OnItemRemoved);
+		}
+		
+		m_Character = null;
+		m_InventoryManager = null;
+		m_CharacterStorage = null;
+		m_aCharacterStorages.Clear();
+		m_aContainerSlots.Clear();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	bool IsBoundTo(IEntity character)
+	{
+		return character && m_Character == character;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Storage components of the character itself, only slots that can hold something
+	array<BaseInventoryStorageComponent> GetCharacterStorages()
+	{
+		return m_aCharacterStorages;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Clothing slots holding a deposit storage, in slot order
+	array<InventoryStorageSlot> GetContainerSlots()
+	{
+		return m_aContainerSlots;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void OnItemAdded(IEntity item, BaseInventoryStorageComponent storageOwner)
+	{
+		if (!item || !m_CharacterStorage)
+			return;
+		
+		// Only items worn by the character change the tree, contents of containers do not
+		InventoryItemComponent itemComponent = InventoryItemComponent.Cast(item.FindComponent(InventoryItemComponent));
+		if (!itemComponent)
+			return;
+		
+		InventoryStorageSlot slot = itemComponent.GetParentSlot();
+		if (!slot || slot.GetStorage() != m_CharacterStorage)
+			return;
+		
+		m_iUpdateCount++;
+		m_aContainerSlots.RemoveItemOrdered(slot);
+		
+		BaseInventoryStorageComponent storage = BaseInventoryStorageComponent.Cast(item.FindComponent(BaseInventoryStorageComponent));
+		if (!storage || !SCR_Enum.HasFlag(storage.GetPurpose(), EStoragePurpose.PURPOSE_DEPOSIT))
+			return;
+		
+		foreach (int i, InventoryStorageSlot containerSlot : m_aContainerSlots)
+		{
+			if (containerSlot.GetID() > slot.GetID())
+			{
+				m_aContainerSlots.InsertAt(slot, i);
+				return;
+			}
+		}
+		
+		m_aContainerSlots.Insert(slot);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void OnItemRemoved(IEntity item, BaseInventoryStorageComponent storageOwner)
+	{
+		// Few containers are worn, checking them all is cheaper than finding the slot the item left
+		for (int i = m_aContainerSlots.Count() - 1; i >= 0; i--)
+		{
+			InventoryStorageSlot containerSlot = m_aContainerSlots[i];
+			if (!containerSlot)
+			{
+				m_aContainerSlots.RemoveOrdered(i);
+				continue;
+			}
+			
+			IEntity attached = containerSlot.GetAttachedEntity();
+			if (attached && attached != item)
+				continue;
+			
+			m_aContainerSlots.RemoveOrdered(i);
+			m_iUpdateCount++;
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetBuildCount()
+	{
+		return m_iBuildCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetUpdateCount()
+	{
+		return m_iUpdateCount;
+	}
+}
@@ -0,0 +1,168 @@
+// PQD Loadout Editor - Initial Sync Scheduler
+// Author: PQD Team
+// Version: 1.0.0
+// Description: Server-side admission queue spreading initial loadout syncs over time after a join storm
+
+//------------------------------------------------------------------------------------------------
+//! One player waiting for the initial sync
+sealed class PQD_InitialSyncTicket
+{
+	PQD_PlayerControllerComponent component;
+	int enqueueTime;
+	int readyTime;
+}
+
+//------------------------------------------------------------------------------------------------
+//! Static admission queue, processed a few tickets per frame
+class PQD_InitialSyncScheduler
+{
+	// Defaults used when the game mode has no PQD_GameModeComponent
+	static const int DEFAULT_SYNCS_PER_FRAME = 2;
+	static const int DEFAULT_JITTER_MS = 3000;
+	
+	// Hard time budget per frame, on top of the ticket count
+	static const int FRAME_BUDGET_MS = 4;
+	
+	protected static ref array<ref PQD_InitialSyncTicket> s_aQueue = {};
+	protected static bool s_bTicking;
+	
+	// Metrics
+	protected static int s_iPeakQueueDepth;
+	protected static int s_iProcessedCount;
+	protected static int s_iTotalWaitMs;
+	protected static int s_iMaxWaitMs;
+	
+	//------------------------------------------------------------------------------------------------
+	//! Queue the initial sync of a player, a player already in the queue is not added twice
+	static void Enqueue(PQD_PlayerControllerComponent component)
+	{
+		if (!component)
+			return;
+		
+		foreach (PQD_InitialSyncTicket queued : s_aQueue)
+		{
+			if (queued.component == component)
+				return;
+		}
+		
+		PQD_InitialSyncTicket ticket = new PQD_InitialSyncTicket();
+		ticket.component = component;
+		ticket.enqueueTime = System.GetTickCount();
+		ticket.readyTime = ticket.enqueueTime;
+		
+		// A lone join is synced right away, jitter only spreads a storm the next frame cannot absorb
+		if (s_aQueue.Count() >= GetSyncsPerFrame())
+		{
+			int jitterMs = DEFAULT_JITTER_MS;
+			PQD_GameModeComponent gameModeComponent = PQD_GameModeComponent.GetInstance();
+			if (gameModeComponent)
+				jitterMs = gameModeComponent.GetInitialSyncJitterMs();
+			
+			if (jitterMs > 0)
+				ticket.readyTime += Math.RandomInt(0, jitterMs);
+		}
+		
+		s_aQueue.Insert(ticket);
+		s_iPeakQueueDepth = Math.Max(s_iPeakQueueDepth, s_aQueue.Count());
+		
+		if (!s_bTicking)
+		{
+			s_bTicking = true;
+			GetGame().GetCallqueue().CallLater(Tick, 0, true);
+		}
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static int GetSyncsPerFrame()
+	{
+		PQD_GameModeComponent gameModeComponent = PQD_GameModeComponent.GetInstance();
+		if (gameModeComponent)
+			return gameModeComponent.GetInitialSyncsPerFrame();
+		
+		return DEFAULT_SYNCS_PER_FRAME;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void Tick()
+	{
+		int budget = GetSyncsPerFrame();
+		int frameStart = System.GetTickCount();
+		int processed;
+		
+		for (int i = 0; i < s_aQueue.Count(); i++)
+		{
+			if (processed >= budget || System.GetTickCount() - frameStart >= FRAME_BUDGET_MS)
+				break;
+			
+			PQD_InitialSyncTicket ticket = s_aQueue[i];
+			if (ticket.readyTime > frameStart)
+				continue;
+			
+			s_aQueue.RemoveOrdered(i);
+			i--;
+			
+			// Player left while waiting
+			if (!ticket.component)
+				continue;
+			
+			int waitMs = frameStart - ticket.enqueueTime;
+			s_iTotalWaitMs += waitMs;
+			s_iMaxWaitMs = Math.Max(s_iMaxWaitMs, waitMs);
+			s_iProcessedCount++;
+			processed++;
+			
+			ticket.component.ProcessInitialSync();
+		}
+		
+		if (!s_aQueue.IsEmpty())
+			return;
+		
+		GetGame().GetCallqueue().Remove(Tick);
+		s_bTicking = false;
+		
+		Print(string.Format("[PQD] InitialSync: Queue drained - %1 processed, peak depth %2, avg wait %3 ms, max wait %4 ms",
+			s_iProcessedCount, s_iPeakQueueDepth, GetAverageWaitMs(), s_iMaxWaitMs), LogLevel.NORMAL);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetQueueDepth()
+	{
+		return s_aQueue.Count();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetPeakQueueDepth()
+	{
+		return s_iPeakQueueDepth;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetProcessedCount()
+	{
+		return s_iProcessedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetAverageWaitMs()
+	{
+		if (s_iProcessedCount == 0)
+			return 0;
+		
+		return s_iTotalWaitMs / s_iProcessedCount;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static int GetMaxWaitMs()
+	{
+		return s_iMaxWaitMs;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	static void ResetMetrics()
+	{
+		s_iPeakQueueDepth = s_aQueue.Count();
+		s_iProcessedCount = 0;
+		s_iTotalWaitMs = 0;
+		s_iMaxWaitMs = 0;
+	}
+}
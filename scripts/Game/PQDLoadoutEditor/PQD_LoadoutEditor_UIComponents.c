@@ -203,6 +203,39 @@ class PQD_SlotsUIComponent : ScriptedWidgetComponent
 		int index = m_aItems.Count();
 		itemWidget.SetZOrder(index);
 		
+		SetupSlotWidget(itemWidget, slotInfo);
+		
+		// Add button handler - the root widget IS the button
+		ButtonWidget button = ButtonWidget.Cast(itemWidget);
+		if (button)
+		{
+			PQD_SlotButtonHandler handler = new PQD_SlotButtonHandler();
+			handler.Init(this, index);
+			button.AddHandler(handler);
+		}
+		
+		m_aItems.Insert(itemWidget);
+		m_aItemData.Insert(slotInfo);
+		
+		return index;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Show new content in an existing slot row, keeps its position and focus
+	bool UpdateItem_Slot(int index, PQD_SlotInfo slotInfo)
+	{
+		if (!m_aItems.IsIndexValid(index) || !slotInfo)
+			return false;
+		
+		slotInfo.listBoxChildId = index;
+		SetupSlotWidget(m_aItems[index], slotInfo);
+		m_aItemData[index] = slotInfo;
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected void SetupSlotWidget(Widget itemWidget, PQD_SlotInfo slotInfo)
+	{
 		// Set up widget content - try different widget names for compatibility
 		TextWidget nameText = TextWidget.Cast(itemWidget.FindAnyWidget("SlotText"));
 		if (nameText)
@@ -230,20 +263,13 @@ class PQD_SlotsUIComponent : ScriptedWidgetComponent
 		{
 			SetupItemPreview(itemWidget, slotInfo.prefab);
 		}
-		
-		// Add button handler - the root widget IS the button
-		ButtonWidget button = ButtonWidget.Cast(itemWidget);
-		if (button)
+		else
 		{
-			PQD_SlotButtonHandler handler = new PQD_SlotButtonHandler();
-			handler.Init(this, index);
-			button.AddHandler(handler);
+			// Row may be reused for an emptied slot
+			Widget previewWidget = itemWidget.FindAnyWidget("SlotPreview");
+			if (previewWidget)
+				previewWidget.SetVisible(false);
 		}
-		
-		m_aItems.Insert(itemWidget);
-		m_aItemData.Insert(slotInfo);
-		
-		return index;
 	}
 	
 	//------------------------------------------------------------------------------------------------
@@ -470,7 +496,11 @@ class PQD_SlotsUIComponent : ScriptedWidgetComponent
 		}
 
 		// Parse the loadout data
-		SCR_PlayerLoadoutData playerLoadoutData = ConvertJsonToLoadoutData(loadoutData);
+		SCR_PlayerLoadoutData playerLoadoutData;
+		PQD_ParsedLoadout parsedLoadout = PQD_ParsedLoadout.Get(loadoutData);
+		if (parsedLoadout)
+			playerLoadoutData = parsedLoadout.ToPlayerLoadoutData();
+		
 		if (!playerLoadoutData || (playerLoadoutData.Clothings.IsEmpty() && playerLoadoutData.Weapons.IsEmpty()))
 		{
 			Print("[PQD] SetupLoadoutPreviewWithEquipment: No equipment data found, using base preview", LogLevel.DEBUG);
@@ -563,112 +593,6 @@ class PQD_SlotsUIComponent : ScriptedWidgetComponent
 		}
 	}
 
-	//------------------------------------------------------------------------------------------------
-	//! Helper: Convert JSON loadout data to SCR_PlayerLoadoutData structure (adapted from PQD_ModdedDeployMenu)
-	protected SCR_PlayerLoadoutData ConvertJsonToLoadoutData(string loadoutData)
-	{
-		if (loadoutData.IsEmpty())
-			return null;
-
-		SCR_PlayerLoadoutData result = new SCR_PlayerLoadoutData();
-
-		// Parse the JSON
-		SCR_JsonLoadContext context = new SCR_JsonLoadContext();
-		if (!context.ImportFromString(loadoutData))
-		{
-			Print("[PQD] ConvertJsonToLoadoutData: Failed to parse JSON", LogLevel.WARNING);
-			return null;
-		}
-
-		// Start reading the arsenalLoadout object
-		if (!context.StartObject(SCR_PlayerArsenalLoadout.ARSENALLOADOUT_KEY))
-		{
-			Print("[PQD] ConvertJsonToLoadoutData: No arsenalLoadout object", LogLevel.WARNING);
-			return null;
-		}
-
-		// Read storages array
-		int storageCount;
-		if (!context.StartArray("storages", storageCount))
-		{
-			context.EndObject();
-			return result;
-		}
-
-		// Process each storage
-		for (int nStorage = 0; nStorage < storageCount; nStorage++)
-		{
-			if (!context.StartObject())
-				continue;
-
-			// Read storage ID to determine type
-			string storageId;
-			if (!context.ReadValue("id", storageId))
-			{
-				context.EndObject();
-				continue;
-			}
-
-			// Determine storage type based on ID
-			bool isWeaponStorage = storageId.Contains("EquipedWeaponStorageComponent");
-			bool isClothingStorage = storageId.Contains("SCR_CharacterInventoryStorageComponent");
-
-			// Read slots
-			int slotCount;
-			if (!context.StartMap("slots", slotCount))
-			{
-				context.EndObject();
-				continue;
-			}
-
-			// Process each slot
-			for (int i = 0; i < slotCount; i++)
-			{
-				string slotIdxStr;
-				if (!context.ReadMapKey(i, slotIdxStr))
-					continue;
-
-				int slotIdx = slotIdxStr.ToInt(-1);
-				if (slotIdx == -1)
-					continue;
-
-				if (!context.StartObject(slotIdxStr))
-					continue;
-
-				// Read the prefab
-				ResourceName itemPrefab;
-				if (context.ReadValue("prefab", itemPrefab) && !itemPrefab.IsEmpty())
-				{
-					if (isWeaponStorage)
-					{
-						SCR_WeaponLoadoutData weaponData = new SCR_WeaponLoadoutData();
-						weaponData.SlotIdx = slotIdx;
-						weaponData.WeaponPrefab = itemPrefab;
-						weaponData.Active = (slotIdx == 0);
-						result.Weapons.Insert(weaponData);
-					}
-					else if (isClothingStorage)
-					{
-						SCR_ClothingLoadoutData clothingData = new SCR_ClothingLoadoutData();
-						clothingData.SlotIdx = slotIdx;
-						clothingData.ClothingPrefab = itemPrefab;
-						result.Clothings.Insert(clothingData);
-					}
-				}
-
-				context.EndObject();
-			}
-
-			context.EndMap();
-			context.EndObject();
-		}
-
-		context.EndArray();
-		context.EndObject();
-
-		return result;
-	}
-
 	//------------------------------------------------------------------------------------------------
 	//! Set supply cost and rank requirement information on item widget
 	protected void SetSupplyAndRankInformation(Widget itemWidget, ResourceName prefab)
@@ -13,21 +13,7 @@ modded class SCR_ArsenalManagerComponent
 	//! \return True if cost was calculated successfully
 	bool PQD_GetLoadoutRespawnCost(string loadout, SCR_Faction faction, out float cost)
 	{
-		if (!faction)
-			return false;
-		
-		SCR_ArsenalPlayerLoadout playerLoadout = new SCR_ArsenalPlayerLoadout;
-		playerLoadout.loadout = loadout;
-		playerLoadout.suppliesCost = 0.0;
-		
-		SCR_JsonLoadContext context = new SCR_JsonLoadContext(false);
-		if (!context.ImportFromString(playerLoadout.loadout))
-			return false;
-		
-		SCR_PlayerArsenalLoadout.ComputeSuppliesCost(context, faction, playerLoadout, SCR_EArsenalSupplyCostType.RESPAWN_COST);
-
-		cost = playerLoadout.suppliesCost;
-		return true;
+		return PQD_LoadoutCostCache.GetCost(loadout, faction, SCR_EArsenalSupplyCostType.RESPAWN_COST, cost);
 	}
 	
 	//------------------------------------------------------------------------------------------------
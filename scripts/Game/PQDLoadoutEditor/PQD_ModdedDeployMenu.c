@@ -79,6 +79,12 @@ modded class SCR_LoadoutGallery : SCR_GalleryComponent
 		if (arsenalLoadout && arsenalLoadout.IsPQDLoadoutSlot())
 		{
 			Print(string.Format("[PQD] LoadoutGallery: Adding PQD loadout slot %1", arsenalLoadout.GetPQDSlotId()), LogLevel.DEBUG);
+			
+			// Load the kit's prefabs before the player previews it
+			string prefab, loadoutData, requiredRank;
+			float cost;
+			if (PQD_ClientLoadoutCache.GetLoadoutData(arsenalLoadout.GetFactionKey(), arsenalLoadout.GetPQDSlotIndex(), prefab, loadoutData, cost, requiredRank))
+				PQD_PrefabPreloader.PreloadLoadout(prefab, loadoutData);
 		}
 		
 		// Call the original implementation
@@ -148,6 +154,9 @@ modded class SCR_PlayerLoadoutComponent : ScriptComponent
 					{
 						// Add to pending loadout manager to guarantee it's available when spawn happens
 						PQD_PendingLoadoutManager.AddPendingLoadout(playerId, slotId, loadoutData, factionKey, prefab);
+						
+						// Load the kit's prefabs while the player is still in the deploy menu
+						PQD_PrefabPreloader.PreloadLoadout(prefab, loadoutData);
 						Print(string.Format("[PQD] Pre-cached loadout data for player %1, slot %2 (data size: %3 bytes)", 
 							playerId, slotId, loadoutData.Length()), LogLevel.NORMAL);
 					}
@@ -293,7 +302,11 @@ modded class SCR_LoadoutPreviewComponent : ScriptedWidgetComponent
 		Print(string.Format("[PQD] Preview: Using loadout data for %1 slot %2 (size: %3)", factionKey, slotIndex, loadoutData.Length()), LogLevel.DEBUG);
 		
 		// Convert our JSON data to SCR_PlayerLoadoutData
-		SCR_PlayerLoadoutData playerLoadoutData = PQD_ConvertJsonToLoadoutData(loadoutData);
+		SCR_PlayerLoadoutData playerLoadoutData;
+		PQD_ParsedLoadout parsedLoadout = PQD_ParsedLoadout.Get(loadoutData);
+		if (parsedLoadout)
+			playerLoadoutData = parsedLoadout.ToPlayerLoadoutData();
+		
 		if (!playerLoadoutData || (playerLoadoutData.Clothings.IsEmpty() && playerLoadoutData.Weapons.IsEmpty()))
 		{
 			Print("[PQD] Preview: No clothing/weapon data found", LogLevel.DEBUG);
@@ -412,123 +425,4 @@ modded class SCR_LoadoutPreviewComponent : ScriptedWidgetComponent
 		
 		return previewedEntity;
 	}
-	
-	//------------------------------------------------------------------------------------------------
-	//! Convert JSON loadout data to SCR_PlayerLoadoutData structure
-	protected SCR_PlayerLoadoutData PQD_ConvertJsonToLoadoutData(string loadoutData)
-	{
-		if (loadoutData.IsEmpty())
-			return null;
-		
-		SCR_PlayerLoadoutData result = new SCR_PlayerLoadoutData();
-		
-		// Parse the JSON
-		SCR_JsonLoadContext context = new SCR_JsonLoadContext();
-		if (!context.ImportFromString(loadoutData))
-		{
-			Print("[PQD] ConvertJsonToLoadoutData: Failed to parse JSON", LogLevel.WARNING);
-			return null;
-		}
-		
-		// Start reading the arsenalLoadout object
-		if (!context.StartObject(SCR_PlayerArsenalLoadout.ARSENALLOADOUT_KEY))
-		{
-			Print("[PQD] ConvertJsonToLoadoutData: No arsenalLoadout object", LogLevel.WARNING);
-			return null;
-		}
-		
-		// Read storages array
-		int storageCount;
-		if (!context.StartArray("storages", storageCount))
-		{
-			context.EndObject();
-			return result;
-		}
-		
-		Print(string.Format("[PQD] ConvertJsonToLoadoutData: Found %1 storages", storageCount), LogLevel.DEBUG);
-		
-		// Process each storage
-		for (int nStorage = 0; nStorage < storageCount; nStorage++)
-		{
-			if (!context.StartObject())
-				continue;
-			
-			// Read storage ID to determine type
-			string storageId;
-			if (!context.ReadValue("id", storageId))
-			{
-				context.EndObject();
-				continue;
-			}
-			
-			Print(string.Format("[PQD] Processing storage: %1", storageId), LogLevel.DEBUG);
-			
-			// Determine storage type based on ID
-			// Weapons are in EquipedWeaponStorageComponent
-			// Clothes are in SCR_CharacterInventoryStorageComponent (slots 0-5: head, jacket, vest, pants, boots, backpack)
-			bool isWeaponStorage = storageId.Contains("EquipedWeaponStorageComponent");
-			bool isClothingStorage = storageId.Contains("SCR_CharacterInventoryStorageComponent");
-			
-			// Read slots
-			int slotCount;
-			if (!context.StartMap("slots", slotCount))
-			{
-				context.EndObject();
-				continue;
-			}
-			
-			Print(string.Format("[PQD] Storage has %1 slots", slotCount), LogLevel.DEBUG);
-			
-			// Process each slot
-			for (int i = 0; i < slotCount; i++)
-			{
-				string slotIdxStr;
-				if (!context.ReadMapKey(i, slotIdxStr))
-					continue;
-				
-				int slotIdx = slotIdxStr.ToInt(-1);
-				if (slotIdx == -1)
-					continue;
-				
-				if (!context.StartObject(slotIdxStr))
-					continue;
-				
-				// Read the prefab - stored as "prefab" key
-				ResourceName itemPrefab;
-				if (context.ReadValue("prefab", itemPrefab) && !itemPrefab.IsEmpty())
-				{
-					Print(string.Format("[PQD] Found item at slot %1: %2", slotIdx, itemPrefab), LogLevel.DEBUG);
-					
-					if (isWeaponStorage)
-					{
-						SCR_WeaponLoadoutData weaponData = new SCR_WeaponLoadoutData();
-						weaponData.SlotIdx = slotIdx;
-						weaponData.WeaponPrefab = itemPrefab;
-						weaponData.Active = (slotIdx == 0);
-						result.Weapons.Insert(weaponData);
-					}
-					else if (isClothingStorage)
-					{
-						SCR_ClothingLoadoutData clothingData = new SCR_ClothingLoadoutData();
-						clothingData.SlotIdx = slotIdx;
-						clothingData.ClothingPrefab = itemPrefab;
-						result.Clothings.Insert(clothingData);
-					}
-				}
-				
-				context.EndObject();
-			}
-			
-			context.EndMap();
-			context.EndObject();
-		}
-		
-		context.EndArray();
-		context.EndObject();
-		
-		Print(string.Format("[PQD] ConvertJsonToLoadoutData: Found %1 clothes, %2 weapons", 
-			result.Clothings.Count(), result.Weapons.Count()), LogLevel.DEBUG);
-		
-		return result;
-	}
 }
@@ -32,6 +32,10 @@ modded class SCR_LoadoutManager : GenericEntity
 		if (faction)
 			factionKey = faction.GetFactionKey();
 		
+		// Fetch this faction's slots and kits if the initial sync did not include it
+		if (!Replication.IsServer())
+			PQD_ClientLoadoutCache.RequestFaction(factionKey);
+		
 		Print(string.Format("[PQD] GetPlayerLoadoutsByFaction: faction=%1, returned %2 loadouts", factionKey, result), LogLevel.NORMAL);
 		
 		foreach (SCR_BasePlayerLoadout loadout : outLoadouts)
@@ -22,6 +22,17 @@ class PQD_CachedLoadoutData
 	}
 }
 
+//------------------------------------------------------------------------------------------------
+//! Client cache as stored in the client's profile, one file per server
+class PQD_PersistedLoadoutCache
+{
+	int formatVersion;
+	string serverId;
+	ref map<string, ref array<int>> validSlots = new map<string, ref array<int>>();
+	ref map<string, int> versions = new map<string, int>();
+	ref array<ref PQD_LoadoutDataTransfer> loadouts = {};
+}
+
 //------------------------------------------------------------------------------------------------
 //! Static cache for valid loadout slots AND loadout data on the client-side
 //! This is populated by the server via RPC when player connects or saves loadouts
@@ -36,6 +47,21 @@ class PQD_ClientLoadoutCache
 	// Flag to track if cache has been initialized from server
 	protected static bool s_bCacheInitialized = false;
 	
+	// Factions already asked for on demand - the initial sync only covers the player's faction
+	protected static ref array<string> s_aRequestedFactions = {};
+	
+	// Factions confirmed by the server this session
+	protected static ref array<string> s_aSyncedFactions = {};
+	
+	// Map: factionKey -> server content version of that faction's slots
+	protected static ref map<string, int> s_mFactionVersions = new map<string, int>();
+	
+	// Profile persistence, keyed by server identity
+	static const string PROFILE_CACHE_PATH = "$profile:/PQDLoadoutEditor_ClientCache";
+	static const int PROFILE_CACHE_FORMAT = 1;
+	static const int MAX_SERVER_ID_LENGTH = 64;
+	protected static string s_sServerId;
+	
 	//------------------------------------------------------------------------------------------------
 	//! Get the key for loadout data map
 	protected static string GetLoadoutKey(string factionKey, int slotIndex)
@@ -57,6 +83,10 @@ class PQD_ClientLoadoutCache
 		
 		if (!s_mValidSlots.Contains(factionKey))
 		{
+			// Show slots until the faction's data arrives, same as before initialization
+			if (RequestFaction(factionKey))
+				return true;
+			
 			Print(string.Format("[PQD] ClientCache: No data for faction %1", factionKey), LogLevel.DEBUG);
 			return false;
 		}
@@ -74,6 +104,235 @@ class PQD_ClientLoadoutCache
 		return isValid;
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Ask the server for a faction that is not cached yet
+	//! \return true while the faction's data is still on its way
+	static bool RequestFaction(string factionKey)
+	{
+		if (factionKey.IsEmpty() || s_aSyncedFactions.Contains(factionKey))
+			return false;
+		
+		if (!s_aRequestedFactions.Contains(factionKey))
+		{
+			PQD_PlayerControllerComponent pcComponent = PQD_PlayerControllerComponent.LocalInstance;
+			if (!pcComponent)
+				return false;
+			
+			s_aRequestedFactions.Insert(factionKey);
+			pcComponent.RequestFactionSlots(factionKey, GetFactionVersion(factionKey));
+			
+			Print(string.Format("[PQD] ClientCache: Requesting faction %1", factionKey), LogLevel.DEBUG);
+		}
+		
+		// Data restored from the profile stays usable while it is reconciled
+		return !s_mValidSlots.Contains(factionKey);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Content version of the cached data for a faction, 0 if unknown
+	static int GetFactionVersion(string factionKey)
+	{
+		return s_mFactionVersions.Get(factionKey);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Record the server version of a faction, cached kits of an outdated version are dropped
+	static void SetFactionVersion(string factionKey, int version)
+	{
+		if (!s_aSyncedFactions.Contains(factionKey))
+			s_aSyncedFactions.Insert(factionKey);
+		
+		if (s_mFactionVersions.Get(factionKey) == version)
+			return;
+		
+		for (int slotIndex = 0; slotIndex < PQD_PlayerFactionLoadoutStorage.MAX_LOADOUTS_PER_PLAYER; slotIndex++)
+		{
+			ClearLoadoutData(factionKey, slotIndex);
+		}
+		
+		s_mFactionVersions.Set(factionKey, version);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Apply a saved or cleared slot to a faction's cached data and move it to the new version
+	//! \return false if the cache did not hold previousVersion, the faction must then be fetched again
+	static bool ApplySlotChange(string factionKey, int slotIndex, bool isValid, int previousVersion, int version)
+	{
+		array<int> validSlots = s_mValidSlots.Get(factionKey);
+		if (!validSlots || previousVersion == 0 || s_mFactionVersions.Get(factionKey) != previousVersion)
+			return false;
+		
+		if (isValid)
+		{
+			if (!validSlots.Contains(slotIndex))
+			{
+				validSlots.Insert(slotIndex);
+				validSlots.Sort();
+			}
+		}
+		else
+		{
+			validSlots.RemoveItem(slotIndex);
+			ClearLoadoutData(factionKey, slotIndex);
+		}
+		
+		s_mFactionVersions.Set(factionKey, version);
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Known faction versions as JSON, sent to the server so unchanged factions are not resent
+	static string ExportFactionVersions()
+	{
+		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
+		saveContext.WriteValue("versions", s_mFactionVersions);
+		return saveContext.ExportToString();
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! The id comes from the server and becomes a file name, only [A-Za-z0-9_-] is accepted
+	protected static bool IsValidServerId(string serverId)
+	{
+		int length = serverId.Length();
+		if (length == 0 || length > MAX_SERVER_ID_LENGTH)
+			return false;
+		
+		for (int i = 0; i < length; i++)
+		{
+			int c = serverId.ToAscii(i);
+			if (c >= 48 && c <= 57)		// 0-9
+				continue;
+			if (c >= 65 && c <= 90)		// A-Z
+				continue;
+			if (c >= 97 && c <= 122)	// a-z
+				continue;
+			if (c == 95 || c == 45)		// _ -
+				continue;
+			
+			return false;
+		}
+		
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static string GetProfileCachePath(string serverId)
+	{
+		return string.Format("%1/%2.json", PROFILE_CACHE_PATH, serverId);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Restore the cache saved during the last session on this server
+	static bool LoadFromProfile(string serverId)
+	{
+		s_sServerId = "";
+		
+		if (serverId.IsEmpty())
+			return false;
+		
+		// Without a usable id nothing is loaded or saved this session
+		if (!IsValidServerId(serverId))
+		{
+			Print(string.Format("[PQD] ClientCache: Ignoring invalid server id '%1'", serverId.Substring(0, Math.Min(serverId.Length(), MAX_SERVER_ID_LENGTH))), LogLevel.WARNING);
+			return false;
+		}
+		
+		s_sServerId = serverId;
+		
+		if (!PQD_Helpers.IsFileSavingEnabled())
+			return false;
+		
+		string path = GetProfileCachePath(serverId);
+		if (!FileIO.FileExists(path))
+			return false;
+		
+		SCR_JsonLoadContext loadContext = new SCR_JsonLoadContext();
+		if (!loadContext.LoadFromFile(path))
+			return false;
+		
+		PQD_PersistedLoadoutCache persisted = new PQD_PersistedLoadoutCache();
+		if (!loadContext.ReadValue("", persisted) || persisted.formatVersion != PROFILE_CACHE_FORMAT || persisted.serverId != serverId)
+		{
+			Print(string.Format("[PQD] ClientCache: Ignoring outdated profile cache %1", path), LogLevel.DEBUG);
+			return false;
+		}
+		
+		foreach (string factionKey, array<int> slots : persisted.validSlots)
+		{
+			// Never overwrite data the server already sent this session
+			if (s_aSyncedFactions.Contains(factionKey))
+				continue;
+			
+			UpdateCache(factionKey, slots);
+			s_mFactionVersions.Set(factionKey, persisted.versions.Get(factionKey));
+		}
+		
+		foreach (PQD_LoadoutDataTransfer transfer : persisted.loadouts)
+		{
+			if (!transfer || s_aSyncedFactions.Contains(transfer.factionKey))
+				continue;
+			
+			SetLoadoutData(transfer.factionKey, transfer.slotIndex, transfer.prefab, transfer.loadoutData, transfer.cost, transfer.requiredRank);
+		}
+		
+		Print(string.Format("[PQD] ClientCache: Restored %1 factions and %2 loadouts from profile", persisted.validSlots.Count(), persisted.loadouts.Count()), LogLevel.NORMAL);
+		return true;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	//! Save to the profile a moment after the last change, so a streamed sync is written once
+	static void ScheduleSaveToProfile()
+	{
+		if (s_sServerId.IsEmpty())
+			return;
+		
+		GetGame().GetCallqueue().Remove(SaveToProfile);
+		GetGame().GetCallqueue().CallLater(SaveToProfile, 2000, false);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	protected static void SaveToProfile()
+	{
+		if (s_sServerId.IsEmpty() || !PQD_Helpers.IsFileSavingEnabled())
+			return;
+		
+		PQD_PersistedLoadoutCache persisted = new PQD_PersistedLoadoutCache();
+		persisted.formatVersion = PROFILE_CACHE_FORMAT;
+		persisted.serverId = s_sServerId;
+		
+		foreach (string factionKey, array<int> slots : s_mValidSlots)
+		{
+			persisted.validSlots.Set(factionKey, slots);
+			persisted.versions.Set(factionKey, s_mFactionVersions.Get(factionKey));
+			
+			foreach (int slotIndex : slots)
+			{
+				PQD_CachedLoadoutData cached = s_mLoadoutData.Get(GetLoadoutKey(factionKey, slotIndex));
+				if (!cached)
+					continue;
+				
+				PQD_LoadoutDataTransfer transfer = new PQD_LoadoutDataTransfer();
+				transfer.factionKey = factionKey;
+				transfer.slotIndex = slotIndex;
+				transfer.prefab = cached.prefab;
+				transfer.loadoutData = cached.loadoutData;
+				transfer.cost = cached.cost;
+				transfer.requiredRank = cached.requiredRank;
+				persisted.loadouts.Insert(transfer);
+			}
+		}
+		
+		if (!FileIO.FileExists(PROFILE_CACHE_PATH))
+			FileIO.MakeDirectory(PROFILE_CACHE_PATH);
+		
+		SCR_JsonSaveContext saveContext = new SCR_JsonSaveContext();
+		saveContext.WriteValue("", persisted);
+		
+		string path = GetProfileCachePath(s_sServerId);
+		if (!saveContext.SaveToFile(path))
+			Print(string.Format("[PQD] ClientCache: Failed to write profile cache %1", path), LogLevel.WARNING);
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	//! Update the cache with server data
 	static void UpdateCache(string factionKey, array<int> validSlots)
@@ -148,6 +407,10 @@ class PQD_ClientLoadoutCache
 	{
 		s_mValidSlots.Clear();
 		s_mLoadoutData.Clear();
+		s_aRequestedFactions.Clear();
+		s_aSyncedFactions.Clear();
+		s_mFactionVersions.Clear();
+		s_sServerId = "";
 		s_bCacheInitialized = false;
 		Print("[PQD] ClientCache: Cleared", LogLevel.DEBUG);
 	}
@@ -294,20 +557,6 @@ modded class SCR_PlayerArsenalLoadout : SCR_FactionPlayerLoadout
 		
 		Print(string.Format("[PQD] OnLoadoutSpawned: Processing PQD slot %1 for player %2", m_sPQDSlotId, playerId), LogLevel.NORMAL);
 		
-		// Check if we already have pre-cached loadout from RPC (pre-cached in Rpc_NotifyPQDSelection_S)
-		// This prevents race conditions where RPC arrived before OnLoadoutSpawned
-		if (PQD_PendingLoadoutManager.HasPendingLoadout(playerId))
-		{
-			PQD_PendingLoadout pending = PQD_PendingLoadoutManager.GetPendingLoadout(playerId);
-			if (pending && !pending.loadoutData.IsEmpty())
-			{
-				Print(string.Format("[PQD] OnLoadoutSpawned: Player %1 already has pre-cached pending loadout with %2 bytes of data", 
-					playerId, pending.loadoutData.Length()), LogLevel.NORMAL);
-				return; // Data already cached, OnPlayerSpawned fallback will handle it
-			}
-		}
-		
-		// This is a PQD loadout slot - try to get the data now
 		GameEntity playerEntity = GameEntity.Cast(pOwner);
 		if (!playerEntity)
 		{
@@ -315,6 +564,19 @@ modded class SCR_PlayerArsenalLoadout : SCR_FactionPlayerLoadout
 			return;
 		}
 		
+		// Check if we already have pre-cached loadout from RPC (pre-cached in Rpc_NotifyPQDSelection_S)
+		// This prevents race conditions where RPC arrived before OnLoadoutSpawned
+		PQD_PendingLoadout pending = PQD_PendingLoadoutManager.GetPendingLoadout(playerId);
+		if (pending && !pending.loadoutData.IsEmpty())
+		{
+			Print(string.Format("[PQD] OnLoadoutSpawned: Player %1 already has pre-cached pending loadout with %2 bytes of data", 
+				playerId, pending.loadoutData.Length()), LogLevel.NORMAL);
+			
+			// If it cannot be applied now, the OnPlayerSpawned fallback replaces the entity
+			PQD_ApplyLoadoutAtSpawn(playerEntity, playerId, pending.prefab, pending.loadoutData, pending.factionKey);
+			return;
+		}
+		
 		// Get the storage component from GameMode
 		SCR_BaseGameMode gameMode = SCR_BaseGameMode.Cast(GetGame().GetGameMode());
 		if (!gameMode)
@@ -356,15 +618,46 @@ modded class SCR_PlayerArsenalLoadout : SCR_FactionPlayerLoadout
 			return;
 		}
 		
-		// Don't try to apply loadout to the spawned entity - it doesn't work reliably
-		// Instead, schedule a complete entity replacement after spawn
-		// This is the same approach used successfully in the arsenal
+		if (PQD_ApplyLoadoutAtSpawn(playerEntity, playerId, prefab, loadoutData, factionKey))
+			return;
+		
+		// Spawned with a different character prefab - schedule a complete entity replacement after spawn
 		Print(string.Format("[PQD] OnLoadoutSpawned: Scheduling entity replacement for slot %1 (data size: %2)", m_sPQDSlotId, loadoutData.Length()), LogLevel.NORMAL);
 		
 		// Add to pending loadouts - the fallback will replace the entire entity
 		PQD_PendingLoadoutManager.AddPendingLoadout(playerId, m_sPQDSlotId, loadoutData, factionKey, prefab);
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Apply the loadout to the character while it is being spawned, before the player controls it
+	//! Requires the character prefab the loadout was saved with, unless the respawn component allows any prefab
+	protected bool PQD_ApplyLoadoutAtSpawn(GameEntity playerEntity, int playerId, ResourceName prefab, string loadoutData, string factionKey)
+	{
+		ResourceName spawnedPrefab;
+		PQD_Helpers.GetResourceNameFromEntity(playerEntity, spawnedPrefab);
+		
+		PQD_RespawnLoadoutComponent respawnComp = PQD_RespawnLoadoutComponent.GetInstance();
+		bool anyPrefab = respawnComp && respawnComp.ShouldApplyToAnyPrefabAtSpawn();
+		
+		if (!anyPrefab && spawnedPrefab != prefab)
+		{
+			Print(string.Format("[PQD] OnLoadoutSpawned: Spawned %1 but loadout needs %2", spawnedPrefab, prefab), LogLevel.DEBUG);
+			return false;
+		}
+		
+		PQD_PrefabPreloader.ReportApply(prefab, loadoutData);
+		if (!PQD_ApplyLoadoutToEntity(playerEntity, loadoutData, factionKey))
+			return false;
+		
+		Print(string.Format("[PQD] OnLoadoutSpawned: Applied slot %1 at spawn for player %2", m_sPQDSlotId, playerId), LogLevel.NORMAL);
+		
+		// Nothing left for the OnPlayerSpawned fallback
+		PQD_PendingLoadoutManager.RemovePendingLoadout(playerId);
+		PQD_ServerLoadoutSelection.ClearPlayerSelection(playerId);
+		PQD_ReadinessScheduler.RecordKittedAtSpawn();
+		return true;
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	//! Override: Check if the loadout is available on client
 	//! For PQD loadouts, this checks if the player has saved data for this slot
@@ -475,37 +768,26 @@ modded class SCR_PlayerArsenalLoadout : SCR_FactionPlayerLoadout
 			return false;
 		}
 		
-		// Create JSON load context
-		SCR_JsonLoadContext context = new SCR_JsonLoadContext();
-		
-		if (!context.ImportFromString(loadoutData))
+		// Parsed once per kit, shared with every other player using it
+		PQD_ParsedLoadout parsed = PQD_ParsedLoadout.Get(loadoutData);
+		if (!parsed)
 		{
 			Print("[PQD] PQD_ApplyLoadoutToEntity: Failed to parse loadout data", LogLevel.ERROR);
 			return false;
 		}
 		
 		// Verify faction key matches
-		string factionKey;
-		if (context.ReadValue(SCR_PlayerArsenalLoadout.ARSENALLOADOUT_FACTION_KEY, factionKey))
-		{
-			if (!expectedFactionKey.IsEmpty() && factionKey != expectedFactionKey)
-			{
-				Print(string.Format("[PQD] PQD_ApplyLoadoutToEntity: Faction mismatch - saved: %1, expected: %2", 
-					factionKey, expectedFactionKey), LogLevel.WARNING);
-				return false;
-			}
-		}
-		
-		// CRITICAL: Ensure ARSENALLOADOUT_COMPONENTS_TO_CHECK is initialized
-		if (!SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK || SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK.IsEmpty())
+		string factionKey = parsed.factionKey;
+		if (!factionKey.IsEmpty() && !expectedFactionKey.IsEmpty() && factionKey != expectedFactionKey)
 		{
-			Print("[PQD] PQD_ApplyLoadoutToEntity: Initializing ARSENALLOADOUT_COMPONENTS_TO_CHECK", LogLevel.WARNING);
-			SCR_ArsenalManagerComponent.GetArsenalLoadoutComponentsToCheck(SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK);
+			Print(string.Format("[PQD] PQD_ApplyLoadoutToEntity: Faction mismatch - saved: %1, expected: %2", 
+				factionKey, expectedFactionKey), LogLevel.WARNING);
+			return false;
 		}
 		
 		// Apply the loadout to the entity using the proper static method
 		// This handles all the inventory items, storages, and character data properly
-		if (!SCR_PlayerArsenalLoadout.ApplyLoadoutString(playerEntity, context))
+		if (!PQD_PlayerFactionLoadoutStorage.ApplyToCharacter(playerEntity, loadoutData))
 		{
 			Print("[PQD] PQD_ApplyLoadoutToEntity: Failed to apply loadout to entity", LogLevel.ERROR);
 			return false;
@@ -522,6 +804,13 @@ modded class SCR_PlayerArsenalLoadout : SCR_FactionPlayerLoadout
 		return m_sPQDSlotId;
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Get the PQD slot index, -1 if this is not a PQD slot
+	int GetPQDSlotIndex()
+	{
+		return PQD_GetSlotIndex(m_sPQDSlotId);
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	//! Check if this is a PQD loadout slot
 	bool IsPQDLoadoutSlot()
@@ -22,6 +22,15 @@ sealed class PQD_RespawnLoadoutComponent : SCR_BaseGameModeComponent
 	[Attribute("0", UIWidgets.CheckBox, "Show empty loadout slots in the menu", category: "PQD Loadout Editor")]
 	protected bool m_bShowEmptySlots;
 	
+	[Attribute("0", UIWidgets.CheckBox, "Apply saved loadouts at spawn even if they were saved on a different character prefab, instead of replacing the spawned character", category: "PQD Loadout Editor")]
+	protected bool m_bApplyToAnyPrefabAtSpawn;
+	
+	[Attribute("1", UIWidgets.Slider, "Maximum number of respawn kit replacements processed per frame", "1 10 1", category: "PQD Loadout Editor")]
+	protected int m_iKitAppliesPerFrame;
+	
+	[Attribute("4", UIWidgets.Slider, "Time budget for respawn kit replacements per frame (ms)", "1 20 1", category: "PQD Loadout Editor")]
+	protected int m_iKitApplyFrameBudgetMs;
+	
 	// Static instance for easy access
 	protected static PQD_RespawnLoadoutComponent s_Instance;
 	
@@ -53,6 +62,25 @@ sealed class PQD_RespawnLoadoutComponent : SCR_BaseGameModeComponent
 		return m_bShowEmptySlots;
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Check if loadouts saved on another character prefab are applied to the spawned character
+	bool ShouldApplyToAnyPrefabAtSpawn()
+	{
+		return m_bApplyToAnyPrefabAtSpawn;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetKitAppliesPerFrame()
+	{
+		return m_iKitAppliesPerFrame;
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	int GetKitApplyFrameBudgetMs()
+	{
+		return m_iKitApplyFrameBudgetMs;
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	override void OnPostInit(IEntity owner)
 	{
@@ -80,10 +108,14 @@ modded class SCR_BaseGameMode : BaseGameMode
 {
 	// Max retry attempts for fallback loadout application
 	protected static const int PQD_MAX_RETRY_ATTEMPTS = 3;
-	// Delay between retry attempts in milliseconds
-	protected static const int PQD_RETRY_DELAY_MS = 1000;
-	// Initial delay before first fallback attempt
-	protected static const int PQD_INITIAL_DELAY_MS = 500;
+	
+	// Wait before a failed replacement is tried again, multiplied by the attempt number
+	protected static const int PQD_RETRY_BACKOFF_MS = 500;
+	
+	// What the spawned character must have before it is replaced
+	// On the server these already hold when OnPlayerSpawned runs. PQD_KitApplyQueue checks them again
+	// when the ticket's turn comes, so a character that died or changed hands while queued is skipped
+	static const int PQD_FALLBACK_READINESS = PQD_ReadinessCondition.ENTITY_REPLICATED | PQD_ReadinessCondition.CONTROLLER_READY | PQD_ReadinessCondition.PLAYER_CONTROLLED;
 	
 	//------------------------------------------------------------------------------------------------
 	override void OnPlayerSpawned(int playerId, IEntity controlledEntity)
@@ -102,7 +134,7 @@ modded class SCR_BaseGameMode : BaseGameMode
 			{
 				Print(string.Format("[PQD] Fallback: Player %1 has valid pending loadout with %2 bytes of data", 
 					playerId, pending.loadoutData.Length()), LogLevel.NORMAL);
-				GetGame().GetCallqueue().CallLater(PQD_ApplyFallbackLoadout, PQD_INITIAL_DELAY_MS, false, playerId, controlledEntity);
+				PQD_ScheduleFallbackLoadout(playerId, controlledEntity, System.GetTickCount());
 				return;
 			}
 			else
@@ -146,7 +178,7 @@ modded class SCR_BaseGameMode : BaseGameMode
 						PQD_ServerLoadoutSelection.ClearPlayerSelection(playerId);
 						
 						// Schedule the fallback application
-						GetGame().GetCallqueue().CallLater(PQD_ApplyFallbackLoadout, PQD_INITIAL_DELAY_MS, false, playerId, controlledEntity);
+						PQD_ScheduleFallbackLoadout(playerId, controlledEntity, System.GetTickCount());
 						return;
 					}
 					else
@@ -170,9 +202,23 @@ modded class SCR_BaseGameMode : BaseGameMode
 		}
 	}
 	
+	//------------------------------------------------------------------------------------------------
+	//! Run PQD_ApplyFallbackLoadout as soon as the spawned character is ready, but not before delayMs
+	protected void PQD_ScheduleFallbackLoadout(int playerId, IEntity controlledEntity, int spawnTime, int delayMs = 0)
+	{
+		PQD_FallbackLoadoutReadinessTask task = new PQD_FallbackLoadoutReadinessTask();
+		task.entity = controlledEntity;
+		task.conditions = PQD_FALLBACK_READINESS;
+		task.spawnTime = spawnTime;
+		task.gameMode = this;
+		task.playerId = playerId;
+		
+		PQD_ReadinessScheduler.Enqueue(task, PQD_ReadinessScheduler.DEFAULT_TIMEOUT_MS, delayMs);
+	}
+	
 	//------------------------------------------------------------------------------------------------
 	//! Replace player entity with a new one that has the correct loadout
-	protected void PQD_ApplyFallbackLoadout(int playerId, IEntity controlledEntity)
+	void PQD_ApplyFallbackLoadout(int playerId, IEntity controlledEntity, int spawnTime)
 	{
 		// Get the pending loadout
 		PQD_PendingLoadout pending = PQD_PendingLoadoutManager.GetPendingLoadout(playerId);
@@ -211,14 +257,16 @@ modded class SCR_BaseGameMode : BaseGameMode
 			Print(string.Format("[PQD] Fallback: Successfully replaced entity for player %1 with loadout from slot %2", 
 				playerId, pending.slotId), LogLevel.NORMAL);
 			PQD_PendingLoadoutManager.RemovePendingLoadout(playerId);
+			PQD_ReadinessScheduler.RecordKitted(spawnTime);
 			return;
 		}
 		
 		// Check if we should retry
 		if (pending.retryCount < PQD_MAX_RETRY_ATTEMPTS)
 		{
-			Print(string.Format("[PQD] Fallback: Failed to replace entity, will retry in %1ms", PQD_RETRY_DELAY_MS), LogLevel.WARNING);
-			GetGame().GetCallqueue().CallLater(PQD_ApplyFallbackLoadout, PQD_RETRY_DELAY_MS, false, playerId, controlledEntity);
+			int delayMs = PQD_RETRY_BACKOFF_MS * pending.retryCount;
+			Print(string.Format("[PQD] Fallback: Failed to replace entity, will retry in %1 ms", delayMs), LogLevel.WARNING);
+			PQD_ScheduleFallbackLoadout(playerId, controlledEntity, spawnTime, delayMs);
 		}
 		else
 		{
@@ -229,7 +277,7 @@ modded class SCR_BaseGameMode : BaseGameMode
 	
 	//------------------------------------------------------------------------------------------------
 	//! Replace entity with a new one with the correct loadout (similar to arsenal approach)
-	protected bool PQD_ReplaceEntityWithLoadout(int playerId, GameEntity oldEntity, string prefab, string loadoutData, string factionKey)
+	bool PQD_ReplaceEntityWithLoadout(int playerId, GameEntity oldEntity, string prefab, string loadoutData, string factionKey)
 	{
 		if (prefab.IsEmpty())
 		{
@@ -249,6 +297,8 @@ modded class SCR_BaseGameMode : BaseGameMode
 		oldEntity.GetWorldTransform(params.Transform);
 		params.Transform[3] = params.Transform[3] + (vector.Up * 0.05);
 		
+		PQD_PrefabPreloader.ReportApply(prefab, loadoutData);
+		
 		// Load prefab resource
 		Resource loaded = Resource.Load(prefab);
 		if (!loaded)
@@ -297,26 +347,8 @@ modded class SCR_BaseGameMode : BaseGameMode
 		
 		Print(string.Format("[PQD] Fallback: Spawned new entity, applying loadout data (size: %1 bytes)", loadoutData.Length()), LogLevel.NORMAL);
 		
-		// CRITICAL: Ensure ARSENALLOADOUT_COMPONENTS_TO_CHECK is initialized before calling ApplyLoadoutString
-		// This array tells the vanilla system which storage components to process for items
-		// Without it, only equipped items are applied, not inventory items inside storages!
-		if (!SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK || SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK.IsEmpty())
-		{
-			Print("[PQD] Fallback: Initializing ARSENALLOADOUT_COMPONENTS_TO_CHECK (was not initialized!)", LogLevel.WARNING);
-			SCR_ArsenalManagerComponent.GetArsenalLoadoutComponentsToCheck(SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK);
-		}
-		
-		// Parse and apply loadout data
-		SCR_JsonLoadContext context = new SCR_JsonLoadContext();
-		if (!context.ImportFromString(loadoutData))
-		{
-			Print("[PQD] Fallback: Failed to parse loadout JSON", LogLevel.ERROR);
-			RplComponent.DeleteRplEntity(newEntity, false);
-			return false;
-		}
-		
 		// Apply loadout to the NEW entity (this should work because it's a fresh entity)
-		if (!SCR_PlayerArsenalLoadout.ApplyLoadoutString(newGameEntity, context))
+		if (!PQD_PlayerFactionLoadoutStorage.ApplyToCharacter(newGameEntity, loadoutData))
 		{
 			Print("[PQD] Fallback: ApplyLoadoutString failed on new entity", LogLevel.ERROR);
 			RplComponent.DeleteRplEntity(newEntity, false);
@@ -387,24 +419,8 @@ modded class SCR_BaseGameMode : BaseGameMode
 			return false;
 		}
 		
-		// Create JSON load context
-		SCR_JsonLoadContext context = new SCR_JsonLoadContext();
-		
-		if (!context.ImportFromString(loadoutData))
-		{
-			Print("[PQD] Fallback: Failed to parse loadout data", LogLevel.ERROR);
-			return false;
-		}
-		
-		// CRITICAL: Ensure ARSENALLOADOUT_COMPONENTS_TO_CHECK is initialized
-		if (!SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK || SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK.IsEmpty())
-		{
-			Print("[PQD] DeprecatedFallback: Initializing ARSENALLOADOUT_COMPONENTS_TO_CHECK", LogLevel.WARNING);
-			SCR_ArsenalManagerComponent.GetArsenalLoadoutComponentsToCheck(SCR_PlayerArsenalLoadout.ARSENALLOADOUT_COMPONENTS_TO_CHECK);
-		}
-		
 		// Try to apply using the vanilla system
-		if (!SCR_PlayerArsenalLoadout.ApplyLoadoutString(playerEntity, context))
+		if (!PQD_PlayerFactionLoadoutStorage.ApplyToCharacter(playerEntity, loadoutData))
 		{
 			Print("[PQD] Fallback: ApplyLoadoutString failed", LogLevel.ERROR);
 			return false;
@@ -414,3 +430,38 @@ modded class SCR_BaseGameMode : BaseGameMode
 		return true;
 	}
 }
+
+//------------------------------------------------------------------------------------------------
+//! Fallback loadout replacement waiting for the character the player spawned with
+sealed class PQD_FallbackLoadoutReadinessTask : PQD_ReadinessTask
+{
+	SCR_BaseGameMode gameMode;
+	int playerId;
+	
+	//------------------------------------------------------------------------------------------------
+	override bool IsValid()
+	{
+		return entity && gameMode && PQD_PendingLoadoutManager.HasPendingLoadout(playerId);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override void OnReady()
+	{
+		// Replacements of a deploy wave are spread over several frames
+		PQD_KitApplyQueue.Enqueue(gameMode, playerId, entity, spawnTime);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override void OnTimeout()
+	{
+		Print(string.Format("[PQD] Fallback: Character of player %1 never became ready, giving up", playerId), LogLevel.ERROR);
+		PQD_PendingLoadoutManager.RemovePendingLoadout(playerId);
+	}
+	
+	//------------------------------------------------------------------------------------------------
+	override void OnInvalid()
+	{
+		Print(string.Format("[PQD] Fallback: Character of player %1 is gone, dropping pending loadout", playerId), LogLevel.DEBUG);
+		PQD_PendingLoadoutManager.RemovePendingLoadout(playerId);
+	}
+}
\ No newline at end of file